@@ -0,0 +1,5 @@
+#!/bin/bash
+# Runs the experiment $1 (mpc, safe_paths or safe_edges) on every component in a single process,
+# for path covers of size <= $2 (a number, or xF for F times the width of every component, default x1)
+mkdir -p ../batch
+../../build/experiments/run_batch ../lgf "$1" "${2:-x1}" > "../batch/$1_${2:-x1}"
@@ -0,0 +1,8 @@
+#!/bin/bash
+# Converts every component to the binary format, run_batch ../bgf reads them without parsing,
+# and packs them into the container ../components.bgc, run_batch ../components.bgc reads it
+mkdir -p ../bgf
+for lgf in ../lgf/component_*.lgf; do
+    ../../build/executables/lgf_to_binary "$lgf" "../bgf/$(basename "$lgf" .lgf).bgf"
+done
+../../build/executables/lgf_to_binary ../bgf ../components.bgc
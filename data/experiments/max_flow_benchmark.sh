@@ -0,0 +1,7 @@
+#!/bin/bash
+# Compares the Max-Flow algorithms on every component for path covers of size <= $1
+mkdir -p ../max_flow_benchmark
+for lgf in ../lgf/component_*.lgf; do
+    component=$(basename "$lgf" .lgf)
+    ../../build/experiments/run_max_flow_benchmark "$lgf" "$1" > "../max_flow_benchmark/${component}_$1"
+done
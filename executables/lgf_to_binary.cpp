@@ -0,0 +1,84 @@
+#include <iostream>
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <dirent.h>
+#include <lemon/list_graph.h>
+
+#include <utils.h>
+#include <binary_instance.h>
+
+
+// Converts a problem instance from LGF to the binary format of binary_instance.h,
+// or packs the instances of a directory into a container file:
+//
+//   lgf_to_binary <input lgf|directory> <output file>
+//
+// The instances of the directory are its .lgf and .bgf files, sorted by name,
+// and they are named by their file name in the container.
+
+
+bool has_suffix(const std::string& s, const std::string& suffix) {
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+
+int pack_directory(DIR* dir, const std::string& input, const std::string& output) {
+    std::vector<std::string> names;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        std::string name = entry->d_name;
+        if (has_suffix(name, ".lgf") || has_suffix(name, ".bgf")) {
+            names.push_back(name);
+        }
+    }
+    closedir(dir);
+    std::sort(names.begin(), names.end());
+
+    try {
+        InstanceContainerWriter container(output);
+        for (const std::string& name : names) {
+            lemon::ListDigraph g;
+            lemon::ListDigraph::NodeMap<int64_t> original_id(g);
+            std::vector<lemon::ListDigraph::Node> S, T, U;
+            load_problem_instance(input + "/" + name, g, original_id, S, T, U);
+            container.add(name, g, original_id, S, T, U);
+        }
+        container.close();
+    } catch (std::exception& error) {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+
+int main(int argc, char*argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <input lgf|directory> <output file>" << std::endl;
+        return 1;
+    }
+
+    DIR* dir = opendir(argv[1]);
+    if (dir != nullptr) {
+        return pack_directory(dir, argv[1], argv[2]);
+    }
+
+    lemon::ListDigraph g;
+    lemon::ListDigraph::NodeMap<int64_t> original_id(g);
+    std::vector<lemon::ListDigraph::Node> S, T, U;
+    try {
+        load_problem_instance(argv[1], g, original_id, S, T, U);
+    } catch (std::exception& error) {
+        std::cerr << "Cannot read " << argv[1] << ": " << error.what() << std::endl;
+        return 1;
+    }
+
+    std::ofstream out(argv[2], std::ios::binary);
+    write_binary_instance(out, g, original_id, S, T, U);
+    if (!out) {
+        std::cerr << "Cannot write " << argv[2] << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,315 @@
+#include <iostream>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <dirent.h>
+#include <time.h>
+#include <lemon/list_graph.h>
+
+#include <utils.h>
+#include <binary_instance.h>
+#include <canonical_form.h>
+#include <scheduler.h>
+#include <algorithms/greedy_approx.h>
+#include <algorithms/mpc.h>
+#include <algorithms/safe_paths.h>
+#include <algorithms/filter_paths.h>
+#include <algorithms/safe_edges.h>
+
+
+// Runs one of the experiments on many components in a single process:
+//
+//   run_batch <directory|container|manifest> <mpc|safe_paths|safe_edges> [l] [threads] [max-flow algorithm] [MPC engine]
+//
+// The components are the .lgf (and binary .bgf, see lgf_to_binary) files of the directory, the
+// instances of the container file (see lgf_to_binary), or the lines "<file> [l]" of the manifest. l is either a number or "xF", F times the width of the component (default x1).
+// The components are first loaded (in parallel), and then processed in parallel starting with
+// the most expensive ones (see run_largest_first). Their results are written to stdout in the
+// order of the input, in the same format as run_mpc and run_safe_paths_safe_edges_opt. The MPCs (and widths)
+// are computed with the given engine (dense or sparse, see MPCEngine).
+// Components with the same structure (see CanonicalForm) and l are solved once, the others report
+// that result with the line "Same structure as = <file>" naming the solved component, and as their
+// time the time of building their canonical form and finding the solved component.
+
+
+struct Component {
+    std::string filename;
+    std::string l;
+    int64_t entry; // Position in the container, -1 if the component is a file
+};
+
+
+struct Instance {
+    lemon::ListDigraph g;
+    lemon::ListDigraph::NodeMap<int64_t> original_id;
+    std::vector<lemon::ListDigraph::Node> S, T, U;
+    std::unique_ptr<CanonicalForm> form;
+
+    Instance() : original_id(g) {}
+};
+
+
+// Result of a task on a component, only what is written (the same for components with the same structure)
+struct Solution {
+    int64_t l;
+    size_t count; // The width, the number of filtered safe paths or of safe edges
+    long time;
+    long filter_time;
+};
+
+
+// CPU time (µs) used by the calling thread so far
+long used_time() {
+    struct timespec time;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return time.tv_sec*1000000 + time.tv_nsec/1000;
+}
+
+
+bool has_suffix(const std::string& s, const std::string& suffix) {
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+
+// Reads the components of a directory (sorted by name), a container or a manifest, false if it cannot be read
+bool read_components(const std::string& input, const std::string& default_l, std::vector<Component>& components, std::unique_ptr<InstanceContainer>& container) {
+    if (is_instance_container(input)) {
+        container.reset(new InstanceContainer(input, true));
+        for (size_t i = 0; i < container->size(); ++i) {
+            components.push_back({input + ":" + container->name(i), default_l, (int64_t) i});
+        }
+        return true;
+    }
+
+    DIR* dir = opendir(input.c_str());
+    if (dir != nullptr) {
+        struct dirent* entry;
+        while ((entry = readdir(dir)) != nullptr) {
+            std::string name = entry->d_name;
+            if (has_suffix(name, ".lgf") || has_suffix(name, ".bgf")) {
+                components.push_back({input + "/" + name, default_l, -1});
+            }
+        }
+        closedir(dir);
+        std::sort(components.begin(), components.end(), [](const Component& a, const Component& b) { return a.filename < b.filename; });
+        return true;
+    }
+
+    std::ifstream manifest(input);
+    if (!manifest) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(manifest, line)) {
+        std::istringstream fields(line);
+        Component component;
+        component.entry = -1;
+        if (!(fields >> component.filename) || component.filename[0] == '#') continue;
+        if (!(fields >> component.l)) {
+            component.l = default_l;
+        }
+        components.push_back(component);
+    }
+    return true;
+}
+
+
+Solution solve_component(const Component& component, Instance& instance, const std::string& task, MaxFlowAlgorithm algorithm, MPCEngine engine) {
+    lemon::ListDigraph& g = instance.g;
+    std::vector<lemon::ListDigraph::Node>& S = instance.S;
+    std::vector<lemon::ListDigraph::Node>& T = instance.T;
+    std::vector<lemon::ListDigraph::Node>& U = instance.U;
+
+    Solution solution;
+    solution.l = 0;
+    solution.filter_time = 0;
+
+    if (task == "mpc") {
+        long start = used_time();
+        std::vector<std::vector<lemon::ListDigraph::Node>> minimum_path_cover = greedy_U_MPC(g,S,T,U,algorithm,engine);
+        solution.time = used_time() - start;
+        solution.count = minimum_path_cover.size();
+        return solution;
+    }
+
+    if (component.l[0] == 'x') {
+        solution.l = atoi(component.l.c_str() + 1) * greedy_U_MPC(g,S,T,U,algorithm,engine).size();
+    } else {
+        solution.l = atoi(component.l.c_str());
+    }
+
+    if (task == "safe_paths") {
+        long start = used_time();
+        SafePathSet safe_paths;
+        compacted_greedy_path_maximal_safe_paths_U_PC(g,S,T,U,solution.l,safe_paths,algorithm);
+        solution.time = used_time() - start;
+
+        start = used_time();
+        filter_contained_paths(g, safe_paths);
+        solution.filter_time = used_time() - start;
+        solution.count = safe_paths.safePathCount();
+    } else {
+        long start = used_time();
+        std::vector<lemon::ListDigraph::Arc> safe_edges = greedy_safe_edges_U_PC(g,S,T,U,solution.l,algorithm);
+        solution.time = used_time() - start;
+        solution.count = safe_edges.size();
+    }
+    return solution;
+}
+
+
+// solved_as is the component that was solved, if the result is the one of a component with the same structure
+std::string write_result(const Component& component, const std::string& task, const Solution& solution, const Component* solved_as = nullptr) {
+    std::ostringstream out;
+    out << "Input_graph = " << component.filename << std::endl;
+    if (solved_as != nullptr) {
+        out << "Same structure as = " << solved_as->filename << std::endl;
+    }
+
+    if (task == "mpc") {
+        out << "width = " << solution.count << std::endl;
+        out << "Time difference Minimum Path Cover(µs) = " << solution.time << std::endl;
+    } else if (task == "safe_paths") {
+        out << "Safe Paths, l = " << solution.l << std::endl;
+        out << "Number of safe paths = " << solution.count << std::endl;
+        out << "Time difference Safe Path (not filtered) (µs) = " << solution.time << std::endl;
+        out << "Time difference Safe Path filter) (µs) = " << solution.filter_time << std::endl;
+    } else {
+        out << "Safe Edges, l = " << solution.l << std::endl;
+        out << "Number of safe edges = " << solution.count << std::endl;
+        out << "Time difference Safe Edges (µs) = " << solution.time << std::endl;
+    }
+    out << std::endl;
+    return out.str();
+}
+
+
+int main(int argc, char*argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <directory|container|manifest> <mpc|safe_paths|safe_edges> [l] [threads] [max-flow algorithm] [MPC engine]" << std::endl;
+        return 1;
+    }
+    std::string task = argv[2];
+    if (task != "mpc" && task != "safe_paths" && task != "safe_edges") {
+        std::cerr << "Unknown task " << task << " (mpc, safe_paths or safe_edges)" << std::endl;
+        return 1;
+    }
+    std::string default_l = (argc > 3) ? argv[3] : "x1";
+    int32_t threads = (argc > 4) ? atoi(argv[4]) : std::thread::hardware_concurrency();
+    MaxFlowAlgorithm algorithm = MaxFlowAlgorithm::EDMONDS_KARP;
+    if (argc > 5 && !parse_max_flow_algorithm(argv[5], algorithm)) {
+        std::cerr << "Unknown max-flow algorithm " << argv[5] << " (edmonds_karp, dinic or push_relabel)" << std::endl;
+        return 1;
+    }
+    MPCEngine engine = MPCEngine::DENSE;
+    if (argc > 6 && !parse_mpc_engine(argv[6], engine)) {
+        std::cerr << "Unknown MPC engine " << argv[6] << " (dense or sparse)" << std::endl;
+        return 1;
+    }
+
+    std::vector<Component> components;
+    std::unique_ptr<InstanceContainer> container;
+    try {
+        if (!read_components(argv[1], default_l, components, container)) {
+            std::cerr << "Cannot read " << argv[1] << std::endl;
+            return 1;
+        }
+    } catch (std::exception& error) {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+
+    // Load the components and estimate their costs
+    std::vector<std::unique_ptr<Instance>> instances(components.size());
+    std::vector<std::string> errors(components.size());
+    std::vector<double> costs(components.size(), 0);
+    std::vector<long> form_times(components.size(), 0); // Building the canonical form, and for a copy finding its structure
+    run_largest_first(std::vector<double>(components.size(), 1), threads, [&](size_t i) {
+        try {
+            std::unique_ptr<Instance> instance(new Instance());
+            if (components[i].entry == -1) {
+                load_problem_instance(components[i].filename, instance->g, instance->original_id, instance->S, instance->T, instance->U);
+            } else {
+                load_binary_instance(container->instance(components[i].entry), instance->g, instance->original_id, instance->S, instance->T, instance->U);
+            }
+            int64_t width = greedy_approximation_U_MPC(instance->g, instance->S, instance->T, instance->U).size();
+            costs[i] = estimate_cost(lemon::countNodes(instance->g), lemon::countArcs(instance->g), width);
+            long start = used_time();
+            instance->form.reset(new CanonicalForm(instance->g, instance->S, instance->T, instance->U));
+            form_times[i] = used_time() - start;
+            instances[i] = std::move(instance);
+        } catch (std::exception& error) { // A component that cannot be read does not stop the others
+            errors[i] = error.what();
+        }
+    });
+
+    // Only the first component of every structure (and l) is solved, the others are its copies
+    std::vector<size_t> solved;
+    std::vector<std::vector<size_t>> copies(components.size());
+    std::unordered_map<size_t, std::vector<size_t>> solved_by_hash;
+    for (size_t i = 0; i < components.size(); ++i) {
+        if (instances[i]) {
+            long start = used_time();
+            bool copy = false;
+            for (size_t j: solved_by_hash[instances[i]->form->hash()]) {
+                if (components[j].l == components[i].l && *instances[j]->form == *instances[i]->form) {
+                    copies[j].push_back(i);
+                    copy = true;
+                    break;
+                }
+            }
+            if (copy) {
+                form_times[i] += used_time() - start;
+                continue;
+            }
+            solved_by_hash[instances[i]->form->hash()].push_back(i);
+        }
+        solved.push_back(i);
+    }
+    std::vector<double> solved_costs;
+    for (size_t i: solved) {
+        solved_costs.push_back(costs[i]);
+    }
+
+    // Every result is written once all the previous ones are written
+    std::vector<std::string> results(components.size());
+    std::vector<bool> done(components.size(), false);
+    size_t next_to_write = 0;
+    std::mutex output_mutex;
+
+    run_largest_first(solved_costs, threads, [&](size_t k) {
+        size_t i = solved[k];
+        std::vector<std::pair<size_t, std::string>> component_results;
+        if (instances[i]) {
+            Solution solution = solve_component(components[i], *instances[i], task, algorithm, engine);
+            component_results.emplace_back(i, write_result(components[i], task, solution));
+            for (size_t j: copies[i]) {
+                Solution copy = solution;
+                copy.time = form_times[j];
+                copy.filter_time = 0;
+                component_results.emplace_back(j, write_result(components[j], task, copy, &components[i]));
+                instances[j].reset();
+            }
+            instances[i].reset();
+        } else {
+            component_results.emplace_back(i, "Input_graph = " + components[i].filename + "\nError = " + errors[i] + "\n\n");
+        }
+
+        std::lock_guard<std::mutex> lock(output_mutex);
+        for (auto& component_result: component_results) {
+            results[component_result.first] = std::move(component_result.second);
+            done[component_result.first] = true;
+        }
+        while (next_to_write < components.size() && done[next_to_write]) {
+            std::cout << results[next_to_write] << std::flush;
+            results[next_to_write].clear();
+            ++next_to_write;
+        }
+    });
+}
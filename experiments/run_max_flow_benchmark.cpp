@@ -0,0 +1,75 @@
+#include <iostream>
+#include <sys/resource.h>
+#include <lemon/list_graph.h>
+
+#include <utils.h>
+#include <algorithms/mpc.h>
+#include <algorithms/safe_paths.h>
+#include <algorithms/safe_edges.h>
+#include <algorithms/max_flow.h>
+
+
+// User+system time (µs) used by the process so far
+long used_time() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec)*1000000 + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+
+int main(int argc, char*argv[]) {
+    std::cout << "Input_graph = " <<  argv[1] << std::endl;
+    int64_t l = atoi(argv[2]);
+    lemon::ListDigraph g;
+    lemon::ListDigraph::NodeMap<int64_t> original_id(g);
+    std::vector<lemon::ListDigraph::Node> S, T, U;
+    load_problem_instance(argv[1], g, original_id, S, T, U);
+
+    std::cout << "Max-Flow benchmark, l = " << l << std::endl;
+
+    std::vector<std::pair<std::string, MaxFlowAlgorithm>> algorithms = {
+            {"edmonds_karp", MaxFlowAlgorithm::EDMONDS_KARP},
+            {"dinic", MaxFlowAlgorithm::DINIC},
+            {"push_relabel", MaxFlowAlgorithm::PUSH_RELABEL}
+    };
+
+    bool width_mismatch = false;
+    for (auto& algorithm : algorithms) {
+        long start = used_time();
+        std::vector<std::vector<lemon::ListDigraph::Node>> minimum_path_cover = greedy_U_MPC(g,S,T,U,algorithm.second);
+        long mpc_time = used_time() - start;
+
+        start = used_time();
+        std::vector<std::vector<lemon::ListDigraph::Node>> sparse_minimum_path_cover = greedy_U_MPC(g,S,T,U,algorithm.second,MPCEngine::SPARSE);
+        long sparse_mpc_time = used_time() - start;
+
+        start = used_time();
+        std::vector<std::pair<std::vector<lemon::ListDigraph::Node>, std::vector<std::vector<lemon::ListDigraph::Node>>>> safe_paths_per_path = optimized_greedy_path_maximal_safe_paths_U_PC(g,S,T,U,l,algorithm.second);
+        long safe_paths_time = used_time() - start;
+
+        start = used_time();
+        std::vector<lemon::ListDigraph::Arc> safe_edges = greedy_safe_edges_U_PC(g,S,T,U,l,algorithm.second);
+        long safe_edges_time = used_time() - start;
+
+        int64_t number_of_safe_paths = 0;
+        for (auto& pair : safe_paths_per_path) {
+            number_of_safe_paths += pair.second.size();
+        }
+
+        std::cout << "Max-Flow algorithm = " << algorithm.first << std::endl;
+        std::cout << "width = " << minimum_path_cover.size() << std::endl;
+        std::cout << "width, sparse engine = " << sparse_minimum_path_cover.size() << std::endl;
+        if (sparse_minimum_path_cover.size() != minimum_path_cover.size()) {
+            std::cerr << "Error: the sparse engine MPC has width " << sparse_minimum_path_cover.size() << " instead of " << minimum_path_cover.size() << std::endl;
+            width_mismatch = true;
+        }
+        std::cout << "Number of safe paths (not filtered) = " << number_of_safe_paths << std::endl;
+        std::cout << "Number of safe edges = " << safe_edges.size() << std::endl;
+        std::cout << "Time difference Minimum Path Cover(µs) = " << mpc_time << std::endl;
+        std::cout << "Time difference Minimum Path Cover, sparse engine(µs) = " << sparse_mpc_time << std::endl;
+        std::cout << "Time difference Safe Path (not filtered) (µs) = " << safe_paths_time << std::endl;
+        std::cout << "Time difference Safe Edges (µs) = " << safe_edges_time << std::endl;
+        std::cout << std::endl;
+    }
+    return width_mismatch ? 1 : 0;
+}
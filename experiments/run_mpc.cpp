@@ -8,6 +8,16 @@
 
 int main(int argc, char*argv[]) {
     std::cout << "Input_graph = " <<  argv[1] << std::endl;
+    MaxFlowAlgorithm algorithm = MaxFlowAlgorithm::EDMONDS_KARP;
+    if (argc > 2 && !parse_max_flow_algorithm(argv[2], algorithm)) {
+        std::cerr << "Unknown max-flow algorithm " << argv[2] << " (edmonds_karp, dinic or push_relabel)" << std::endl;
+        return 1;
+    }
+    MPCEngine engine = MPCEngine::DENSE;
+    if (argc > 3 && !parse_mpc_engine(argv[3], engine)) {
+        std::cerr << "Unknown MPC engine " << argv[3] << " (dense or sparse)" << std::endl;
+        return 1;
+    }
     lemon::ListDigraph g;
     lemon::ListDigraph::NodeMap<int64_t> original_id(g);
     std::vector<lemon::ListDigraph::Node> S, T, U;
@@ -19,7 +29,7 @@ int main(int argc, char*argv[]) {
     getrusage(RUSAGE_SELF, &usage);
     rs_start = usage.ru_stime;
     ru_start = usage.ru_utime;
-    std::vector<std::vector<lemon::ListDigraph::Node>> minimum_path_cover = greedy_U_MPC(g,S,T,U);
+    std::vector<std::vector<lemon::ListDigraph::Node>> minimum_path_cover = greedy_U_MPC(g,S,T,U,algorithm,engine);
     getrusage(RUSAGE_SELF, &usage);
     rs_end = usage.ru_stime;
     ru_end = usage.ru_utime;
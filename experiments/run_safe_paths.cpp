@@ -10,6 +10,11 @@
 int main(int argc, char*argv[]) {
     std::cout << "Input_graph = " <<  argv[1] << std::endl;
     int64_t l = atoi(argv[2]);
+    MaxFlowAlgorithm algorithm = MaxFlowAlgorithm::EDMONDS_KARP;
+    if (argc > 3 && !parse_max_flow_algorithm(argv[3], algorithm)) {
+        std::cerr << "Unknown max-flow algorithm " << argv[3] << " (edmonds_karp, dinic or push_relabel)" << std::endl;
+        return 1;
+    }
     lemon::ListDigraph g;
     lemon::ListDigraph::NodeMap<int64_t> original_id(g);
     std::vector<lemon::ListDigraph::Node> S, T, U;
@@ -22,7 +27,17 @@ int main(int argc, char*argv[]) {
     getrusage(RUSAGE_SELF, &usage);
     rs_start = usage.ru_stime;
     ru_start = usage.ru_utime;
-    std::vector<std::pair<std::vector<lemon::ListDigraph::Node>, std::vector<std::vector<lemon::ListDigraph::Node>>>> safe_paths_per_path = greedy_path_maximal_safe_paths_U_PC(g,S,T,U,l);
+    // The safe paths are stored flat as they are found, the paths of the path cover
+    // are reported in order, so a path is added when its first safe path is reported
+    SafePathSet safe_paths;
+    const lemon::ListDigraph::Node* last_path = nullptr;
+    greedy_path_maximal_safe_paths_U_PC(g,S,T,U,l,[&](PathView path, PathView safe_path) {
+        if (path.begin() != last_path) {
+            safe_paths.addPath(path);
+            last_path = path.begin();
+        }
+        safe_paths.addSafePath(safe_paths.pathCount() - 1, safe_path.begin() - path.begin(), safe_path.end() - path.begin() - 1);
+    },algorithm);
     getrusage(RUSAGE_SELF, &usage);
     rs_end = usage.ru_stime;
     ru_end = usage.ru_utime;
@@ -35,7 +50,7 @@ int main(int argc, char*argv[]) {
     getrusage(RUSAGE_SELF, &usage);
     rs_start = usage.ru_stime;
     ru_start = usage.ru_utime;
-    std::vector<std::vector<lemon::ListDigraph::Node>> filtered_safe_paths = filter_contained_paths(g, safe_paths_per_path);
+    filter_contained_paths(g, safe_paths);
     getrusage(RUSAGE_SELF, &usage);
     rs_end = usage.ru_stime;
     ru_end = usage.ru_utime;
@@ -45,8 +60,9 @@ int main(int argc, char*argv[]) {
     long filter_time = user_time+system_time;
 
 
-    std::cout<< "Number of safe paths = " << filtered_safe_paths.size() << std::endl;
-    for (auto&path : filtered_safe_paths) {
+    std::cout<< "Number of safe paths = " << safe_paths.safePathCount() << std::endl;
+    for (size_t k = 0; k < safe_paths.safePathCount(); ++k) {
+        PathView path = safe_paths.safePath(k);
         for (int i = 0; i < path.size(); ++i) {
             lemon::ListDigraph::Node u = path[i];
             std::cout << original_id[u];
@@ -54,7 +70,7 @@ int main(int argc, char*argv[]) {
                 std::cout << ",";
             }
         }
-        std::cout << std::endl;
+        std::cout << '\n';
     }
 
     std::cout << "Time difference Safe Path (not filtered) (µs) = " << safe_paths_time << std::endl;
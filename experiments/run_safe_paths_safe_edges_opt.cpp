@@ -11,6 +11,12 @@
 int main(int argc, char*argv[]) {
     std::cout << "Input_graph = " <<  argv[1] << std::endl;
     int64_t l = atoi(argv[2]);
+    MaxFlowAlgorithm algorithm = MaxFlowAlgorithm::EDMONDS_KARP;
+    if (argc > 3 && !parse_max_flow_algorithm(argv[3], algorithm)) {
+        std::cerr << "Unknown max-flow algorithm " << argv[3] << " (edmonds_karp, dinic or push_relabel)" << std::endl;
+        return 1;
+    }
+    int32_t threads = (argc > 4) ? atoi(argv[4]) : 1;
     lemon::ListDigraph g;
     lemon::ListDigraph::NodeMap<int64_t> original_id(g);
     std::vector<lemon::ListDigraph::Node> S, T, U;
@@ -23,7 +29,7 @@ int main(int argc, char*argv[]) {
     getrusage(RUSAGE_SELF, &usage);
     rs_start = usage.ru_stime;
     ru_start = usage.ru_utime;
-    std::vector<std::pair<std::vector<lemon::ListDigraph::Node>, std::vector<std::vector<lemon::ListDigraph::Node>>>> safe_paths_per_path = optimized_greedy_path_maximal_safe_paths_U_PC(g,S,T,U,l);
+    std::vector<std::pair<std::vector<lemon::ListDigraph::Node>, std::vector<std::vector<lemon::ListDigraph::Node>>>> safe_paths_per_path = optimized_greedy_path_maximal_safe_paths_U_PC(g,S,T,U,l,algorithm,threads);
     getrusage(RUSAGE_SELF, &usage);
     rs_end = usage.ru_stime;
     ru_end = usage.ru_utime;
@@ -51,7 +57,7 @@ int main(int argc, char*argv[]) {
     getrusage(RUSAGE_SELF, &usage);
     rs_start = usage.ru_stime;
     ru_start = usage.ru_utime;
-    std::vector<lemon::ListDigraph::Arc> safe_edges = greedy_safe_edges_U_PC(g,S,T,U,l);
+    std::vector<lemon::ListDigraph::Arc> safe_edges = greedy_safe_edges_U_PC(g,S,T,U,l,algorithm,threads);
     getrusage(RUSAGE_SELF, &usage);
     rs_end = usage.ru_stime;
     ru_end = usage.ru_utime;
@@ -0,0 +1,49 @@
+#ifndef SAFEPATHSRNAPC_COMPACTION_H
+#define SAFEPATHSRNAPC_COMPACTION_H
+
+#include <lemon/list_graph.h>
+
+#include <algorithms/safe_path_set.h>
+
+
+/*
+ * DAG obtained by contracting the unary chains of g into
+ * single vertices.
+ *
+ * Two consecutive vertices u->v are in the same chain if u->v is
+ * the only out-edge of u and the only in-edge of v, u is not in T
+ * and v is not in S. Then every path of a path cover through one of
+ * them traverses the whole chain, so the path covers of g and of the
+ * compacted DAG are the same, and so are their safe paths.
+ *
+ * A chain is in S if its first vertex is, in T if its last vertex is,
+ * and in U if any of its vertices is. Chains without vertices of U are
+ * not contracted.
+ *
+ * It assumes g is a DAG
+ */
+class CompactedDAG {
+public:
+    CompactedDAG(const lemon::ListDigraph& g, const std::vector<lemon::ListDigraph::Node>& S, const std::vector<lemon::ListDigraph::Node>& T, const std::vector<lemon::ListDigraph::Node>& U);
+
+    lemon::ListDigraph g;
+    std::vector<lemon::ListDigraph::Node> S, T, U;
+
+    // The vertices of the original graph in the chain of v
+    const std::vector<lemon::ListDigraph::Node>& chain(lemon::ListDigraph::Node v) const { return chains[g.id(v)]; }
+
+    // Path of the original graph traversing the chains of path
+    std::vector<lemon::ListDigraph::Node> expand(const std::vector<lemon::ListDigraph::Node>& path) const;
+
+    // Expands the paths of a path cover and their safe paths, adding
+    // the contracted chains that are not part of a safe path
+    std::vector<std::pair<std::vector<lemon::ListDigraph::Node>, std::vector<std::vector<lemon::ListDigraph::Node>>>> expand(const std::vector<std::pair<std::vector<lemon::ListDigraph::Node>, std::vector<std::vector<lemon::ListDigraph::Node>>>>& safe_paths_per_path) const;
+
+    // As above, adding the expanded paths and safe paths to expanded
+    void expand(const SafePathSet& safe_paths, SafePathSet& expanded) const;
+
+private:
+    std::vector<std::vector<lemon::ListDigraph::Node>> chains; // Indexed by the ids of g
+};
+
+#endif //SAFEPATHSRNAPC_COMPACTION_H
@@ -0,0 +1,62 @@
+#ifndef SAFEPATHSRNAPC_DECOMPOSITION_H
+#define SAFEPATHSRNAPC_DECOMPOSITION_H
+
+#include <lemon/list_graph.h>
+
+
+/*
+ * Finds the cut vertices of g, the vertices x
+ * through which every path of every path cover
+ * covering U with paths from S to T passes:
+ * no edge of g jumps over x in a topological order,
+ * no vertex before x is in T and no vertex after x
+ * is in S. The first and last vertices of the order
+ * are never returned.
+ *
+ * It fills order with a topological order of g and
+ * returns the positions of the cut vertices in it,
+ * in increasing order.
+ *
+ * It assumes g is a DAG, sources(g) \subseteq S, sinks(g) \subseteq T
+ */
+std::vector<int32_t> find_cut_vertices(lemon::ListDigraph& g, std::vector<lemon::ListDigraph::Node>& S, std::vector<lemon::ListDigraph::Node>& T, std::vector<lemon::ListDigraph::Node>& order);
+
+
+
+/*
+ * Sub-problem of g on the vertices order[first...last]
+ * between two cut vertices (or the ends of the order),
+ * where paths start at S or at order[first] and end at T
+ * or at order[last]. The cut vertices are added to U, as
+ * every path of g passes through them (it assumes U is not
+ * empty).
+ *
+ * The path covers of g are the combinations of path covers
+ * of the sub-problems between consecutive cut vertices, so
+ * a path inside the sub-problem is safe in g (for the path
+ * covers of size <= l, with l >= width(g)) if and only if
+ * it is safe in the sub-problem.
+ *
+ * position is the position of every vertex in order, and
+ * in_S, in_T and in_U tell (by position) if the vertex is in
+ * S, T or U, so that a sub-problem is built in time linear
+ * in its own size.
+ */
+class SubProblem {
+public:
+    SubProblem(const lemon::ListDigraph& g, const std::vector<lemon::ListDigraph::Node>& order, const lemon::ListDigraph::NodeMap<int32_t>& position, const std::vector<bool>& in_S, const std::vector<bool>& in_T, const std::vector<bool>& in_U, int32_t first, int32_t last);
+
+    lemon::ListDigraph g;
+    std::vector<lemon::ListDigraph::Node> S, T, U;
+
+    // The vertex of the original graph of v
+    lemon::ListDigraph::Node original(lemon::ListDigraph::Node v) const { return vertices[g.id(v)]; }
+
+    // The path of the original graph of path
+    std::vector<lemon::ListDigraph::Node> original(const std::vector<lemon::ListDigraph::Node>& path) const;
+
+private:
+    std::vector<lemon::ListDigraph::Node> vertices; // Indexed by the ids of g
+};
+
+#endif //SAFEPATHSRNAPC_DECOMPOSITION_H
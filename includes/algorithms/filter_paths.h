@@ -4,6 +4,56 @@
 
 #include <lemon/list_graph.h>
 
-std::vector<std::vector<lemon::ListDigraph::Node>> filter_contained_paths(lemon::ListDigraph& g, std::vector<std::pair<std::vector<lemon::ListDigraph::Node>,std::vector<std::vector<lemon::ListDigraph::Node>>>>& safe_paths_per_path);
+#include <algorithms/safe_path_set.h>
+
+/*
+ * Returns the safe paths that are not subpaths of other
+ * safe paths, in their order, reporting only the first
+ * copy of repeated paths.
+ *
+ * A safe path can only occur in a path of the path cover
+ * at the position of its first vertex (g is a DAG), so it
+ * is contained in another one if some interval spans that
+ * occurrence (same path of the path cover or not). The
+ * occurrences are compared by hashes of the prefixes of
+ * the paths of the path cover (and then vertex by vertex),
+ * no text nor suffix structure of the safe paths is built.
+ *
+ * The safe paths are processed in chunks of (about) chunk_size
+ * paths by the ids of their first vertices (0 for a single chunk),
+ * only the occurrences of the first vertices of a chunk are indexed
+ * at a time. Every chunk reads the whole path cover, so smaller
+ * chunks trade time for memory on very large sets of safe paths.
+ */
+std::vector<SafePathInterval> filter_contained_intervals(lemon::ListDigraph& g, const std::vector<std::vector<lemon::ListDigraph::Node>>& path_cover, const std::vector<SafePathInterval>& safe_paths, size_t chunk_size = 0);
+
+
+
+/*
+ * Returns the safe paths (of all the paths of the path cover) that
+ * are not subpaths of other safe paths, in their order, reporting
+ * only the first copy of repeated paths.
+ *
+ * If every safe path is a subpath of its path of the path cover (as
+ * the safe paths of the two finger algorithm), they are filtered by
+ * their coordinates (see filter_contained_intervals, with the given
+ * chunk_size), without copying them. Otherwise the paths are inserted
+ * in a trie with the suffix links of the Aho-Corasick automaton, a path
+ * is contained in another one if its state has children (it is a proper
+ * prefix) or it is reached by suffix links from a state with children
+ * or from the state of a path (it is a suffix of one of those), so the
+ * filter takes time linear in the total length of the paths (times the
+ * out-degree).
+ */
+std::vector<std::vector<lemon::ListDigraph::Node>> filter_contained_paths(lemon::ListDigraph& g, std::vector<std::pair<std::vector<lemon::ListDigraph::Node>,std::vector<std::vector<lemon::ListDigraph::Node>>>>& safe_paths_per_path, size_t chunk_size = 0);
+
+
+
+/*
+ * Keeps only the safe paths of safe_paths that are not subpaths of
+ * other safe paths, as filter_contained_intervals (the paths and the
+ * kept safe paths are not copied)
+ */
+void filter_contained_paths(lemon::ListDigraph& g, SafePathSet& safe_paths, size_t chunk_size = 0);
 
 #endif //SAFEPATHSRNAPC_FILTER_PATHS_H
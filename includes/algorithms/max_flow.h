@@ -0,0 +1,98 @@
+#ifndef SAFEPATHSRNAPC_MAX_FLOW_H
+#define SAFEPATHSRNAPC_MAX_FLOW_H
+
+#include <flow_network.h>
+
+#include <limits>
+#include <string>
+
+
+/*
+ * Algorithms available to compute a maximum flow
+ */
+enum class MaxFlowAlgorithm {
+    EDMONDS_KARP,
+    DINIC,
+    PUSH_RELABEL
+};
+
+
+
+/*
+ * Computes a maximum flow from s to t in red
+ * with the given algorithm.
+ *
+ * capacities and flow are indexed by the arcs of red,
+ * flow is skew-symmetric (flow[a^1] = -flow[a]) and the
+ * residual capacity of an arc a is capacities[a] - flow[a].
+ *
+ * It returns the value of the flow
+ */
+int64_t max_flow(const FlowNetwork& red, const std::vector<int64_t>& capacities, int32_t s, int32_t t, std::vector<int64_t>& flow, MaxFlowAlgorithm algorithm = MaxFlowAlgorithm::EDMONDS_KARP);
+
+
+
+/*
+ * Reads the algorithm from its name (edmonds_karp,
+ * dinic or push_relabel), it returns false if the
+ * name is not valid
+ */
+bool parse_max_flow_algorithm(const std::string& name, MaxFlowAlgorithm& algorithm);
+
+
+
+/*
+ * Flow kept between consecutive Max-Flow computations
+ * on the same network, so that every computation starts
+ * from the previous flow instead of from zero.
+ *
+ * Before the capacity of an arc decreases, or an arc is
+ * disabled or removed, its flow must be cut (fit_flow or
+ * cut_flow), this leaves an excess or deficit at its
+ * endpoints that the next incremental_max_flow repairs.
+ */
+struct IncrementalFlow {
+    std::vector<int64_t> flow; // Skew-symmetric, indexed by the arcs of the network
+    std::vector<int64_t> excess; // Inflow minus outflow of every node
+    std::vector<int32_t> unbalanced; // Nodes whose excess may be different from 0
+};
+
+
+
+/*
+ * Sets the zero flow on every arc of red
+ */
+void reset_incremental_flow(IncrementalFlow& state, const FlowNetwork& red);
+
+
+
+/*
+ * Removes all the flow on the arc a
+ */
+void cut_flow(IncrementalFlow& state, const FlowNetwork& red, int32_t a);
+
+
+
+/*
+ * Removes the flow on the arc a (or its twin)
+ * exceeding its capacity
+ */
+void fit_flow(IncrementalFlow& state, const FlowNetwork& red, const std::vector<int64_t>& capacities, int32_t a);
+
+
+
+/*
+ * Computes a maximum flow from s to t in red starting
+ * from the flow in state: first the excess and deficit
+ * left by the cut flows is repaired, then the flow is
+ * augmented with the given algorithm.
+ *
+ * The augmentation stops as soon as the value of the
+ * flow is at least limit, when only that is needed
+ * (push-relabel always computes a maximum flow).
+ *
+ * It returns the value of the flow
+ */
+int64_t incremental_max_flow(IncrementalFlow& state, const FlowNetwork& red, const std::vector<int64_t>& capacities, int32_t s, int32_t t, int64_t limit = std::numeric_limits<int64_t>::max(), MaxFlowAlgorithm algorithm = MaxFlowAlgorithm::EDMONDS_KARP);
+
+#endif //SAFEPATHSRNAPC_MAX_FLOW_H
@@ -0,0 +1,151 @@
+#ifndef SAFEPATHSRNAPC_MIN_FLOW_REDUCTION_H
+#define SAFEPATHSRNAPC_MIN_FLOW_REDUCTION_H
+
+#include <lemon/list_graph.h>
+
+#include <functional>
+
+#include <flow_network.h>
+#include <algorithms/max_flow.h>
+
+
+
+/*
+ * MinFlow<Greedy+MaxFlow> reduction of the problem of
+ * covering the vertices in U of a DAG g with paths
+ * starting at S and ending at T.
+ *
+ * Every vertex v of g is split into v_in -> v_out, every
+ * edge u -> v becomes u_out -> v_in, and there are edges
+ * s -> v_in for v in S and v_out -> t for v in T.
+ *
+ * The reduction is stored in a FlowNetwork, every map
+ * on its edges is a std::vector indexed by edge. The
+ * edges of the reduction are the forward arcs, the
+ * residual twin of an edge plays the role of its reverse
+ * edge with capacity countNodes(g), so that a Max-Flow
+ * computes how much flow can be removed from the greedy
+ * solution.
+ */
+struct MinFlowReduction {
+    explicit MinFlowReduction(lemon::ListDigraph& g, MaxFlowAlgorithm algorithm = MaxFlowAlgorithm::EDMONDS_KARP, int32_t threads = 1);
+    MinFlowReduction(const MinFlowReduction& other); // With its own maps on g, it must be called from one thread at a time
+
+    lemon::ListDigraph& g;
+    MaxFlowAlgorithm algorithm; // Used for every Max-Flow of the reduction
+    int32_t threads; // Used for the safety tests
+    lemon::ListDigraph::NodeMap<bool> in_U;
+    lemon::ListDigraph::NodeMap<bool> in_S;
+    lemon::ListDigraph::NodeMap<int32_t> split_edges; // v_in -> v_out
+
+    FlowNetwork red;
+    int32_t s;
+    int32_t t;
+    int64_t reverse_capacity; // countNodes(g)
+
+    std::vector<lemon::ListDigraph::Node> original; // Vertex of g of every node of red
+    std::vector<lemon::ListDigraph::Arc> original_edge; // Edge of g of every edge u_out -> v_in
+    std::vector<int64_t> feasible_flow; // From the approximation
+    std::vector<int64_t> capacities; // For the Max-Flow reduction, it is flow-demand
+    std::vector<std::pair<int32_t, int64_t>> capacity_journal; // Modifications {e, delta} of the capacities during a safety test
+    IncrementalFlow warm_flow; // Max-Flow of the last safety test
+
+    // Minimum Path Cover, filled by solve_min_flow_reduction
+    int64_t width;
+    std::vector<std::vector<lemon::ListDigraph::Node>> path_cover;
+    std::vector<std::vector<int32_t>> path_cover_edges_red; // s -> path[0]_in, path[j-1]_out -> path[j]_in, ..., path.back()_out -> t
+    std::vector<std::vector<std::pair<int64_t, int64_t>>> paths_through; // Pairs {i, j}: path_cover_edges_red[i][j] is the edge
+};
+
+
+
+/*
+ * Builds the reduction from the flow of the
+ * greedy approximation of g covering the
+ * vertices in U with paths starting at S
+ * and ending at T
+ */
+void build_greedy_min_flow_reduction(MinFlowReduction& reduction, std::vector<lemon::ListDigraph::Node>& S, std::vector<lemon::ListDigraph::Node>& T, std::vector<lemon::ListDigraph::Node>& U);
+
+
+
+/*
+ * Same as build_greedy_min_flow_reduction, but only keeps
+ * the edges u -> v of g used by the greedy paths and, for
+ * every greedy path p, the one from the in-neighbor of v
+ * appearing last in p. Any other edge from p can be replaced
+ * by the subpath of p reaching that in-neighbor, so the
+ * width is the same, and the reduction has O(k|V|) edges
+ * for a greedy solution of k paths (edges leaving vertices
+ * in no greedy path are all kept).
+ *
+ * It is only meant for computing the Minimum Path Cover,
+ * the safety tests need every edge of g
+ */
+void build_sparse_greedy_min_flow_reduction(MinFlowReduction& reduction, std::vector<lemon::ListDigraph::Node>& S, std::vector<lemon::ListDigraph::Node>& T, std::vector<lemon::ListDigraph::Node>& U);
+
+
+
+/*
+ * Runs the Max-Flow on the reduction and
+ * decomposes the resulting Min-Flow into a
+ * Minimum Path Cover.
+ *
+ * Afterwards the capacity of every edge is
+ * its flow minus its demand
+ */
+void solve_min_flow_reduction(MinFlowReduction& reduction);
+
+
+
+/*
+ * Adds the transitive edge u -> v (with 0 capacity)
+ * to the reduction and returns it
+ */
+int32_t add_transitive_edge(MinFlowReduction& reduction, int32_t u, int32_t v);
+
+
+
+/*
+ * Removes the transitive edges added after the
+ * reduction had arc_count edges
+ */
+void remove_transitive_edges(MinFlowReduction& reduction, int32_t arc_count);
+
+
+
+/*
+ * Tests if the edge e of the path cover is safe
+ * for the path covers of size <= l, that is, if
+ * after removing e (and redistributing its flow)
+ * the width of the reduction is greater than l.
+ *
+ * The reduction is restored before returning
+ */
+bool is_safe_removal(MinFlowReduction& reduction, int32_t e, int64_t l);
+
+
+
+/*
+ * Runs task(r, i) for every i in [0, count), where r
+ * is a reduction only used by the calling thread: the
+ * reduction itself, or with reduction.threads > 1, one
+ * of the copies made for the other threads, which pull
+ * the indices from a shared counter. Every task must
+ * restore r before returning
+ */
+void parallel_for_each(MinFlowReduction& reduction, size_t count, const std::function<void(MinFlowReduction&, size_t)>& task);
+
+
+
+/*
+ * Sets safe_edge[e] for every edge e of the path
+ * cover between two vertices of g that is safe
+ * for the path covers of size <= l
+ *
+ * With reduction.threads > 1 the edges are tested in
+ * parallel (see parallel_for_each)
+ */
+void compute_safe_edges(MinFlowReduction& reduction, int64_t l, std::vector<bool>& safe_edge);
+
+#endif //SAFEPATHSRNAPC_MIN_FLOW_REDUCTION_H
@@ -1,8 +1,39 @@
 #ifndef SAFEPATHSRNAPC_MPC_H
 #define SAFEPATHSRNAPC_MPC_H
 
+#include <string>
+
 #include <lemon/list_graph.h>
 
+#include <algorithms/max_flow.h>
+
+
+/*
+ * Networks on which the Min-flow<Greedy+Max-Flow> MPCs are computed:
+ *
+ *   DENSE    the reduction of the whole graph
+ *   SPARSE   the reduction keeping, for every vertex, only the edges
+ *            of the greedy paths plus one in-edge per greedy path
+ *            (see build_sparse_greedy_min_flow_reduction). With the
+ *            O(k log |V|) greedy paths the Max-Flow runs in
+ *            O(k^2 log^2 |V| |V|) time, independently of |E|
+ *
+ * Both give a MPC of the same width
+ */
+enum class MPCEngine {
+    DENSE,
+    SPARSE
+};
+
+
+
+/*
+ * Reads the engine from its name (dense or sparse),
+ * it returns false if the name is not valid
+ */
+bool parse_mpc_engine(const std::string& name, MPCEngine& engine);
+
+
 
 /*
  * Computes a minimum path cover by
@@ -83,19 +114,11 @@ std::vector<std::vector<lemon::ListDigraph::Node>> U_MPC(lemon::ListDigraph& g,
  * of S and end at some vertex of T
  *
  * It assumes g is a DAG, sources(g) \subseteq S, sinks(g) \subseteq T, U \subseteq V(g)
- */
-std::vector<std::vector<lemon::ListDigraph::Node>> greedy_U_MPC(lemon::ListDigraph& g, std::vector<lemon::ListDigraph::Node>& S, std::vector<lemon::ListDigraph::Node>& T, std::vector<lemon::ListDigraph::Node>& U);
-
-
-/*
- * Computes a minimum path cover covering the vertices of U
- * by reducing the problem to Min-flow<Greedy+Max-Flow>
- * The paths of the path cover must start at some vertex
- * of S and end at some vertex of T
  *
- * It assumes g is a DAG, sources(g) \subseteq S, sinks(g) \subseteq T, U \subseteq V(g)
+ * The Max-Flow is computed with the given algorithm,
+ * on the network of the given engine
  */
-std::vector<std::vector<lemon::ListDigraph::Node>> greedy_U_MPC(lemon::ListDigraph& g, std::vector<lemon::ListDigraph::Node>& S, std::vector<lemon::ListDigraph::Node>& T, std::vector<lemon::ListDigraph::Node>& U);
+std::vector<std::vector<lemon::ListDigraph::Node>> greedy_U_MPC(lemon::ListDigraph& g, std::vector<lemon::ListDigraph::Node>& S, std::vector<lemon::ListDigraph::Node>& T, std::vector<lemon::ListDigraph::Node>& U, MaxFlowAlgorithm algorithm = MaxFlowAlgorithm::EDMONDS_KARP, MPCEngine engine = MPCEngine::DENSE);
 
 
 #endif //SAFEPATHSRNAPC_MPC_H
@@ -3,6 +3,8 @@
 
 #include <lemon/list_graph.h>
 
+#include <algorithms/max_flow.h>
+
 
 
 /*
@@ -22,8 +24,12 @@
  * against l
  *
  *
+ * The Max-Flows are computed with the given algorithm,
+ * and the edges are tested with the given number of
+ * threads (the result does not depend on it)
+ *
  * It returns a list of edges of g, the safe edges
  */
-std::vector<lemon::ListDigraph::Arc> greedy_safe_edges_U_PC(lemon::ListDigraph& g, std::vector<lemon::ListDigraph::Node>& S, std::vector<lemon::ListDigraph::Node>& T, std::vector<lemon::ListDigraph::Node>& U, int64_t l);
+std::vector<lemon::ListDigraph::Arc> greedy_safe_edges_U_PC(lemon::ListDigraph& g, std::vector<lemon::ListDigraph::Node>& S, std::vector<lemon::ListDigraph::Node>& T, std::vector<lemon::ListDigraph::Node>& U, int64_t l, MaxFlowAlgorithm algorithm = MaxFlowAlgorithm::EDMONDS_KARP, int32_t threads = 1);
 
 #endif //SAFEPATHSRNAPC_SAFE_EDGES_H
@@ -0,0 +1,115 @@
+#ifndef SAFEPATHSRNAPC_SAFE_PATH_SET_H
+#define SAFEPATHSRNAPC_SAFE_PATH_SET_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <lemon/list_graph.h>
+
+
+/*
+ * Safe path given by its coordinates in a path cover,
+ * the subpath path_cover[path][x...y]
+ */
+struct SafePathInterval {
+    size_t path;
+    size_t x, y;
+};
+
+
+
+/*
+ * Read-only view of a path stored elsewhere
+ * (it does not own nor copy the vertices)
+ */
+class PathView {
+public:
+    PathView() : first(nullptr), last(nullptr) {}
+    PathView(const lemon::ListDigraph::Node* first, const lemon::ListDigraph::Node* last) : first(first), last(last) {}
+    PathView(const std::vector<lemon::ListDigraph::Node>& path) : first(path.data()), last(path.data() + path.size()) {}
+
+    const lemon::ListDigraph::Node* begin() const { return first; }
+    const lemon::ListDigraph::Node* end() const { return last; }
+    size_t size() const { return last - first; }
+    bool empty() const { return first == last; }
+
+    lemon::ListDigraph::Node operator[](size_t i) const { return first[i]; }
+    lemon::ListDigraph::Node front() const { return *first; }
+    lemon::ListDigraph::Node back() const { return *(last - 1); }
+
+    // The subpath of the vertices x...y
+    PathView subpath(size_t x, size_t y) const { return PathView(first + x, first + y + 1); }
+
+    std::vector<lemon::ListDigraph::Node> toVector() const { return std::vector<lemon::ListDigraph::Node>(first, last); }
+
+private:
+    const lemon::ListDigraph::Node* first;
+    const lemon::ListDigraph::Node* last;
+};
+
+
+
+/*
+ * Paths of a path cover and their safe paths, stored flat: the
+ * vertices of all the paths in a single buffer with the offset of
+ * every path, and every safe path as an interval of its path.
+ *
+ * It holds the same as the std::vector<std::pair<path, safe paths>>
+ * returned by the safe path functions (see toPairs), without a vector
+ * per path nor per safe path, and it is moved without copying them.
+ * The paths and safe paths are read as views into the buffer (valid
+ * until the next path is added).
+ */
+class SafePathSet {
+public:
+    SafePathSet() : path_begin(1, 0) {}
+
+    size_t pathCount() const { return path_begin.size() - 1; }
+    PathView path(size_t i) const { return PathView(nodes.data() + path_begin[i], nodes.data() + path_begin[i + 1]); }
+
+    size_t safePathCount() const { return safe_paths.size(); }
+    PathView safePath(size_t k) const { return path(safe_paths[k].path).subpath(safe_paths[k].x, safe_paths[k].y); }
+    const std::vector<SafePathInterval>& intervals() const { return safe_paths; }
+
+    // Adds a path to the path cover and returns its index
+    template <typename Iterator>
+    size_t addPath(Iterator begin, Iterator end) {
+        nodes.insert(nodes.end(), begin, end);
+        path_begin.push_back(nodes.size());
+        return pathCount() - 1;
+    }
+    size_t addPath(PathView path) { return addPath(path.begin(), path.end()); }
+
+    // Adds the subpath x...y of the i-th path as a safe path
+    void addSafePath(size_t i, size_t x, size_t y) { safe_paths.push_back({i, x, y}); }
+
+    // Keeps only the safe paths k with keep[k], in their order
+    void filterSafePaths(const std::vector<bool>& keep);
+
+    // Adds the paths and safe paths of other, with every vertex v replaced by map(v)
+    template <typename Map>
+    void append(const SafePathSet& other, const Map& map) {
+        size_t first_path = pathCount();
+        nodes.reserve(nodes.size() + other.nodes.size());
+        for (lemon::ListDigraph::Node v: other.nodes) {
+            nodes.push_back(map(v));
+        }
+        for (size_t i = 1; i < other.path_begin.size(); ++i) {
+            path_begin.push_back(path_begin[first_path] + other.path_begin[i]);
+        }
+        for (const SafePathInterval& safe_path: other.safe_paths) {
+            safe_paths.push_back({first_path + safe_path.path, safe_path.x, safe_path.y});
+        }
+    }
+
+    // The paths with their safe paths, as returned by the other safe path functions
+    std::vector<std::pair<std::vector<lemon::ListDigraph::Node>, std::vector<std::vector<lemon::ListDigraph::Node>>>> toPairs() const;
+
+private:
+    std::vector<lemon::ListDigraph::Node> nodes;
+    std::vector<size_t> path_begin;
+    std::vector<SafePathInterval> safe_paths;
+};
+
+#endif //SAFEPATHSRNAPC_SAFE_PATH_SET_H
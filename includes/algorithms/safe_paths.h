@@ -1,8 +1,26 @@
 #ifndef SAFEPATHSRNAPC_SAFE_PATHS_H
 #define SAFEPATHSRNAPC_SAFE_PATHS_H
 
+#include <functional>
+
 #include <lemon/list_graph.h>
 
+#include <algorithms/max_flow.h>
+#include <algorithms/safe_path_set.h>
+
+
+
+/*
+ * Receives the safe paths as they are found: path is the
+ * path of the path cover and safe_path the safe path, a
+ * subpath of it. The views are only valid during the call.
+ *
+ * The safe paths of a path are reported in their order
+ * along the path, and with a single thread the paths
+ * are reported in the order of the path cover
+ */
+typedef std::function<void(PathView path, PathView safe_path)> SafePathCallback;
+
 
 
 /*
@@ -168,8 +186,10 @@ std::vector<std::pair<std::vector<lemon::ListDigraph::Node>, std::vector<std::ve
  * vertices in U,
  * with paths starting at S and ending
  * at T and its corresponding safe_paths
+ *
+ * The Max-Flows are computed with the given algorithm
  */
-std::vector<std::pair<std::vector<lemon::ListDigraph::Node>, std::vector<std::vector<lemon::ListDigraph::Node>>>> greedy_path_maximal_safe_paths_U_MPC(lemon::ListDigraph& g, std::vector<lemon::ListDigraph::Node>& S, std::vector<lemon::ListDigraph::Node>& T, std::vector<lemon::ListDigraph::Node>& U);
+std::vector<std::pair<std::vector<lemon::ListDigraph::Node>, std::vector<std::vector<lemon::ListDigraph::Node>>>> greedy_path_maximal_safe_paths_U_MPC(lemon::ListDigraph& g, std::vector<lemon::ListDigraph::Node>& S, std::vector<lemon::ListDigraph::Node>& T, std::vector<lemon::ListDigraph::Node>& U, MaxFlowAlgorithm algorithm = MaxFlowAlgorithm::EDMONDS_KARP);
 
 
 /*
@@ -368,8 +388,20 @@ std::vector<std::pair<std::vector<lemon::ListDigraph::Node>, std::vector<std::ve
  * vertices in U,
  * with paths starting at S and ending
  * at T and its corresponding safe_paths
+ *
+ * The Max-Flows are computed with the given algorithm
  */
-std::vector<std::pair<std::vector<lemon::ListDigraph::Node>, std::vector<std::vector<lemon::ListDigraph::Node>>>> greedy_path_maximal_safe_paths_U_PC(lemon::ListDigraph& g, std::vector<lemon::ListDigraph::Node>& S, std::vector<lemon::ListDigraph::Node>& T, std::vector<lemon::ListDigraph::Node>& U, int64_t l);
+std::vector<std::pair<std::vector<lemon::ListDigraph::Node>, std::vector<std::vector<lemon::ListDigraph::Node>>>> greedy_path_maximal_safe_paths_U_PC(lemon::ListDigraph& g, std::vector<lemon::ListDigraph::Node>& S, std::vector<lemon::ListDigraph::Node>& T, std::vector<lemon::ListDigraph::Node>& U, int64_t l, MaxFlowAlgorithm algorithm = MaxFlowAlgorithm::EDMONDS_KARP);
+
+
+
+/*
+ * As greedy_path_maximal_safe_paths_U_PC, but every
+ * maximal safe path is passed to report as soon as the two
+ * finger algorithm finds it, instead of being stored
+ * (see SafePathCallback)
+ */
+void greedy_path_maximal_safe_paths_U_PC(lemon::ListDigraph& g, std::vector<lemon::ListDigraph::Node>& S, std::vector<lemon::ListDigraph::Node>& T, std::vector<lemon::ListDigraph::Node>& U, int64_t l, const SafePathCallback& report, MaxFlowAlgorithm algorithm = MaxFlowAlgorithm::EDMONDS_KARP);
 
 
 
@@ -399,8 +431,95 @@ std::vector<std::pair<std::vector<lemon::ListDigraph::Node>, std::vector<std::ve
  * vertices in U,
  * with paths starting at S and ending
  * at T and its corresponding safe_paths
+ *
+ * The Max-Flows are computed with the given algorithm,
+ * and the safe edges and the paths of the path cover are
+ * processed with the given number of threads
+ */
+std::vector<std::pair<std::vector<lemon::ListDigraph::Node>, std::vector<std::vector<lemon::ListDigraph::Node>>>> optimized_greedy_path_maximal_safe_paths_U_PC(lemon::ListDigraph& g, std::vector<lemon::ListDigraph::Node>& S, std::vector<lemon::ListDigraph::Node>& T, std::vector<lemon::ListDigraph::Node>& U, int64_t l, MaxFlowAlgorithm algorithm = MaxFlowAlgorithm::EDMONDS_KARP, int32_t threads = 1);
+
+
+
+/*
+ * As optimized_greedy_path_maximal_safe_paths_U_PC, but adds the
+ * paths of the path cover and their safe paths to safe_paths
+ * (see SafePathSet) instead of copying every safe path into its
+ * own vector. Nothing is added if there are no safe paths
+ */
+void optimized_greedy_path_maximal_safe_paths_U_PC(lemon::ListDigraph& g, std::vector<lemon::ListDigraph::Node>& S, std::vector<lemon::ListDigraph::Node>& T, std::vector<lemon::ListDigraph::Node>& U, int64_t l, SafePathSet& safe_paths, MaxFlowAlgorithm algorithm = MaxFlowAlgorithm::EDMONDS_KARP, int32_t threads = 1);
+
+
+
+/*
+ * As optimized_greedy_path_maximal_safe_paths_U_PC, but every
+ * maximal safe path is passed to report as soon as the two
+ * finger algorithm finds it (see SafePathCallback). With more
+ * than one thread the calls never overlap, but the safe paths
+ * of different paths are interleaved
+ */
+void optimized_greedy_path_maximal_safe_paths_U_PC(lemon::ListDigraph& g, std::vector<lemon::ListDigraph::Node>& S, std::vector<lemon::ListDigraph::Node>& T, std::vector<lemon::ListDigraph::Node>& U, int64_t l, const SafePathCallback& report, MaxFlowAlgorithm algorithm = MaxFlowAlgorithm::EDMONDS_KARP, int32_t threads = 1);
+
+
+
+/*
+ * Computes the same safe paths as
+ * optimized_greedy_path_maximal_safe_paths_U_PC,
+ * but splits g at its cut vertices (see find_cut_vertices),
+ * the vertices every path from S to T passes through.
+ *
+ * Every window between a cut vertex and the next but one
+ * (spanning two consecutive parts of g) is solved as an
+ * independent sub-problem (see SubProblem), the windows
+ * are solved in parallel with the given number of threads.
+ * A safe path crossing a cut vertex is found in the window
+ * containing both of its sides, and when a safe path may
+ * continue beyond its window the cut vertex at the end of
+ * the window is dropped and the windows are solved again.
+ * Only the windows changed by the dropped cut vertices are
+ * solved again, and the windows solved over all the rounds
+ * have at most 3|V| vertices: a round that would exceed this,
+ * or that would leave a single window, is not solved, and the
+ * whole graph is solved as by
+ * optimized_greedy_path_maximal_safe_paths_U_PC instead (the
+ * first round has less than 2|V| + #cuts vertices, as every
+ * vertex is in at most two windows).
+ *
+ * It returns the paths of the MPCs of the windows with their
+ * safe paths (the safe paths of overlapping windows repeat,
+ * and the non-maximal ones are removed by filter_contained_paths)
+ */
+std::vector<std::pair<std::vector<lemon::ListDigraph::Node>, std::vector<std::vector<lemon::ListDigraph::Node>>>> decomposed_greedy_path_maximal_safe_paths_U_PC(lemon::ListDigraph& g, std::vector<lemon::ListDigraph::Node>& S, std::vector<lemon::ListDigraph::Node>& T, std::vector<lemon::ListDigraph::Node>& U, int64_t l, MaxFlowAlgorithm algorithm = MaxFlowAlgorithm::EDMONDS_KARP, int32_t threads = 1);
+
+
+
+/*
+ * As decomposed_greedy_path_maximal_safe_paths_U_PC,
+ * adding the result to safe_paths (see SafePathSet)
+ */
+void decomposed_greedy_path_maximal_safe_paths_U_PC(lemon::ListDigraph& g, std::vector<lemon::ListDigraph::Node>& S, std::vector<lemon::ListDigraph::Node>& T, std::vector<lemon::ListDigraph::Node>& U, int64_t l, SafePathSet& safe_paths, MaxFlowAlgorithm algorithm = MaxFlowAlgorithm::EDMONDS_KARP, int32_t threads = 1);
+
+
+
+/*
+ * Computes the same safe paths as
+ * decomposed_greedy_path_maximal_safe_paths_U_PC,
+ * but first contracts the unary chains of g
+ * (see CompactedDAG), so that the reduction is
+ * smaller and the edges inside a chain are not
+ * tested.
+ *
+ * The paths of the path cover and the safe paths
+ * are returned as paths of g
+ */
+std::vector<std::pair<std::vector<lemon::ListDigraph::Node>, std::vector<std::vector<lemon::ListDigraph::Node>>>> compacted_greedy_path_maximal_safe_paths_U_PC(lemon::ListDigraph& g, std::vector<lemon::ListDigraph::Node>& S, std::vector<lemon::ListDigraph::Node>& T, std::vector<lemon::ListDigraph::Node>& U, int64_t l, MaxFlowAlgorithm algorithm = MaxFlowAlgorithm::EDMONDS_KARP, int32_t threads = 1);
+
+
+
+/*
+ * As compacted_greedy_path_maximal_safe_paths_U_PC,
+ * adding the result to safe_paths (see SafePathSet)
  */
-std::vector<std::pair<std::vector<lemon::ListDigraph::Node>, std::vector<std::vector<lemon::ListDigraph::Node>>>> optimized_greedy_path_maximal_safe_paths_U_PC(lemon::ListDigraph& g, std::vector<lemon::ListDigraph::Node>& S, std::vector<lemon::ListDigraph::Node>& T, std::vector<lemon::ListDigraph::Node>& U, int64_t l);
+void compacted_greedy_path_maximal_safe_paths_U_PC(lemon::ListDigraph& g, std::vector<lemon::ListDigraph::Node>& S, std::vector<lemon::ListDigraph::Node>& T, std::vector<lemon::ListDigraph::Node>& U, int64_t l, SafePathSet& safe_paths, MaxFlowAlgorithm algorithm = MaxFlowAlgorithm::EDMONDS_KARP, int32_t threads = 1);
 
 
 
@@ -0,0 +1,217 @@
+#ifndef SAFEPATHSRNAPC_BINARY_INSTANCE_H
+#define SAFEPATHSRNAPC_BINARY_INSTANCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <lemon/list_graph.h>
+
+
+/*
+ * Binary problem instance, meant to be mapped in memory and
+ * read without parsing. All the fields are in the byte order of
+ * the machine that wrote the file:
+ *
+ *   header            magic "SPRNAPC", version, node count n, arc count m
+ *   original_id       int64[n]
+ *   S, T, U           bitsets of uint64[(n+63)/64] each, bit v of
+ *                     word v/64 is set if node v is in the set
+ *   first_out         int32[n+1], out-arcs of v are first_out[v]...first_out[v+1]-1
+ *   targets           int32[m], target of every arc (CSR order)
+ *
+ * Every section starts at a multiple of 8 bytes.
+ */
+struct BinaryInstanceHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    int64_t node_count;
+    int64_t arc_count;
+};
+
+const char BINARY_INSTANCE_MAGIC[8] = {'S', 'P', 'R', 'N', 'A', 'P', 'C', '\0'};
+const uint32_t BINARY_INSTANCE_VERSION = 1;
+
+
+
+/*
+ * Read-only view of a binary instance stored in memory
+ * (it does not own nor copy the data)
+ */
+class BinaryInstance {
+public:
+    // Checks the header and the size of the data, it throws std::runtime_error if they are not valid
+    BinaryInstance(const char* data, size_t size);
+
+    // Size in bytes of an instance with n nodes and m arcs
+    static size_t byteSize(int64_t n, int64_t m);
+
+    // True if data starts with the magic of a binary instance
+    static bool hasMagic(const char* data, size_t size);
+
+    int32_t nodeCount() const { return node_count; }
+    int32_t arcCount() const { return arc_count; }
+
+    int32_t outBegin(int32_t v) const { return first_out[v]; }
+    int32_t outEnd(int32_t v) const { return first_out[v + 1]; }
+    int32_t target(int32_t a) const { return targets[a]; }
+
+    int64_t originalId(int32_t v) const { return original_id[v]; }
+    bool isSource(int32_t v) const { return (S[v >> 6] >> (v & 63)) & 1; }
+    bool isTarget(int32_t v) const { return (T[v >> 6] >> (v & 63)) & 1; }
+    bool isVertexConstrain(int32_t v) const { return (U[v >> 6] >> (v & 63)) & 1; }
+
+private:
+    int32_t node_count;
+    int32_t arc_count;
+    const int64_t* original_id;
+    const uint64_t* S;
+    const uint64_t* T;
+    const uint64_t* U;
+    const int32_t* first_out;
+    const int32_t* targets;
+};
+
+
+
+/*
+ * A file mapped read-only in memory, unmapped on destruction
+ */
+class MappedFile {
+public:
+    // It throws std::runtime_error if the file cannot be mapped, if sequential
+    // the kernel is told that the file will be read from start to end
+    explicit MappedFile(const std::string& filename, bool sequential = false);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+
+private:
+    const char* bytes;
+    size_t length;
+};
+
+
+
+/*
+ * True if the file starts with the magic of a binary instance
+ */
+bool is_binary_instance(const std::string& filename);
+
+
+
+/*
+ * Builds g (adding nodes and arcs to it) from a binary instance,
+ * the nodes are added in the order of the instance and the
+ * out-arcs of every node are iterated in the order of the instance.
+ * S, T and U are filled in the order of lemon::ListDigraph::NodeIt
+ */
+void load_binary_instance(const BinaryInstance& instance, lemon::ListDigraph& g, lemon::ListDigraph::NodeMap<int64_t>& original_id, std::vector<lemon::ListDigraph::Node>& S, std::vector<lemon::ListDigraph::Node>& T, std::vector<lemon::ListDigraph::Node>& U);
+
+
+
+/*
+ * Writes g as a binary instance, the nodes are
+ * numbered by increasing lemon id and the out-arcs
+ * of every node are written in lemon::ListDigraph::OutArcIt
+ * order. Loading the instance into an empty graph gives the
+ * nodes, node ids and out-arc order of g (if its node ids are
+ * 0...n-1, as when g is read from a LGF file)
+ */
+void write_binary_instance(std::ostream& out, const lemon::ListDigraph& g, const lemon::ListDigraph::NodeMap<int64_t>& original_id, const std::vector<lemon::ListDigraph::Node>& S, const std::vector<lemon::ListDigraph::Node>& T, const std::vector<lemon::ListDigraph::Node>& U);
+
+
+
+
+/*
+ * Container file packing many binary instances (for example all the
+ * components of a dataset) with an index:
+ *
+ *   header            magic "SPRNAPCC", version, instance count k, index offset
+ *   instances         the k binary instances, each starting at a multiple of 8 bytes
+ *   index             k entries (offset, size, name offset, name length)
+ *   names             the names of the instances, concatenated
+ *
+ * The index is written last, so that the instances can be
+ * written one by one without keeping them in memory.
+ */
+struct InstanceContainerHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    int64_t instance_count;
+    int64_t index_offset;
+};
+
+struct InstanceContainerEntry {
+    int64_t offset;
+    int64_t size;
+    int64_t name_offset; // From the end of the index
+    int64_t name_length;
+};
+
+const char INSTANCE_CONTAINER_MAGIC[8] = {'S', 'P', 'R', 'N', 'A', 'P', 'C', 'C'};
+const uint32_t INSTANCE_CONTAINER_VERSION = 1;
+
+
+
+/*
+ * Container file mapped in memory, its instances are read
+ * zero-copy by their position in the container (their id)
+ */
+class InstanceContainer {
+public:
+    // It throws std::runtime_error if the file is not a valid container
+    explicit InstanceContainer(const std::string& filename, bool sequential = false);
+
+    size_t size() const { return instance_count; }
+
+    std::string name(size_t i) const;
+
+    // It throws std::runtime_error if the instance is not valid
+    BinaryInstance instance(size_t i) const;
+
+private:
+    MappedFile file;
+    size_t instance_count;
+    const InstanceContainerEntry* index;
+    const char* names;
+};
+
+
+
+/*
+ * Writes a container file, adding the instances one by one
+ */
+class InstanceContainerWriter {
+public:
+    // It throws std::runtime_error if the file cannot be created
+    explicit InstanceContainerWriter(const std::string& filename);
+
+    void add(const std::string& name, const lemon::ListDigraph& g, const lemon::ListDigraph::NodeMap<int64_t>& original_id, const std::vector<lemon::ListDigraph::Node>& S, const std::vector<lemon::ListDigraph::Node>& T, const std::vector<lemon::ListDigraph::Node>& U);
+
+    // Writes the index, it throws std::runtime_error if the file could not be written
+    void close();
+
+private:
+    std::ofstream out;
+    std::vector<InstanceContainerEntry> index;
+    std::string names;
+};
+
+
+
+/*
+ * True if the file starts with the magic of a container
+ */
+bool is_instance_container(const std::string& filename);
+
+#endif //SAFEPATHSRNAPC_BINARY_INSTANCE_H
@@ -0,0 +1,50 @@
+#ifndef SAFEPATHSRNAPC_CANONICAL_FORM_H
+#define SAFEPATHSRNAPC_CANONICAL_FORM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <lemon/list_graph.h>
+
+
+/*
+ * Structural form of a problem instance (g, S, T, U), used to
+ * solve the instances with the same structure once (for example
+ * the many small bubbles of a genome).
+ *
+ * The vertices are numbered (their positions) by a color that does
+ * not depend on the lemon ids nor on the original ids: the color of
+ * a vertex combines its membership to S, T and U with the colors of
+ * its predecessors (in topological order), of its successors (in
+ * reverse topological order), and of its neighbours. Vertices with
+ * the same color are numbered in lemon::ListDigraph::NodeIt order.
+ *
+ * The key encodes every vertex (S, T, U and the positions of its
+ * out-neighbours) by position, so two instances with the same key
+ * are isomorphic through their positions, and any result written
+ * with positions (see position) is a result of both. Isomorphic
+ * instances may still get different keys (when the colors do not
+ * tell apart their vertices and NodeIt lists them differently),
+ * then they are just solved twice.
+ *
+ * It assumes g is a DAG
+ */
+class CanonicalForm {
+public:
+    CanonicalForm(const lemon::ListDigraph& g, const std::vector<lemon::ListDigraph::Node>& S, const std::vector<lemon::ListDigraph::Node>& T, const std::vector<lemon::ListDigraph::Node>& U);
+
+    int32_t position(lemon::ListDigraph::Node v) const { return positions_by_id[lemon::ListDigraph::id(v)]; }
+
+    size_t hash() const { return key_hash; }
+
+    bool operator==(const CanonicalForm& other) const { return key_hash == other.key_hash && encoding == other.encoding; }
+    bool operator!=(const CanonicalForm& other) const { return !(*this == other); }
+
+private:
+    std::vector<int32_t> positions_by_id;
+    std::vector<int64_t> encoding;
+    size_t key_hash;
+};
+
+#endif //SAFEPATHSRNAPC_CANONICAL_FORM_H
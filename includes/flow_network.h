@@ -0,0 +1,138 @@
+#ifndef SAFEPATHSRNAPC_FLOW_NETWORK_H
+#define SAFEPATHSRNAPC_FLOW_NETWORK_H
+
+#include <cstdint>
+#include <vector>
+
+
+/*
+ * Flow network stored in compressed sparse row (CSR) layout.
+ *
+ * Arcs come in pairs: arc 2i is the i-th arc added and arc 2i+1
+ * is its residual twin, going in the opposite direction, so that
+ * twin(a) = a^1. After build() the out-arcs of every node
+ * (including the residual twins of its in-arcs) are contiguous
+ * int32 arrays.
+ *
+ * Arcs added after build() are temporary: they are kept in a
+ * per-node list after the CSR arcs of their source and must be
+ * removed in LIFO order with popArcs().
+ *
+ * An arc pair can be disabled, hiding it from OutArcIt
+ * (and therefore from every search and flow algorithm)
+ * without modifying the layout.
+ *
+ * Arc maps (capacities, flows, ...) are plain std::vector indexed
+ * by arc, with arcCount() entries.
+ */
+class FlowNetwork {
+public:
+    static const int32_t INVALID_ARC = -1;
+
+    FlowNetwork();
+
+    int32_t addNode();
+
+    // Adds the arc u->v (and its twin v->u), returns the id of u->v
+    int32_t addArc(int32_t u, int32_t v);
+
+    // Lays out the arcs added so far in CSR order
+    void build();
+
+    // Removes temporary arcs until arcCount() == arc_count
+    void popArcs(int32_t arc_count);
+
+    // Hides (shows) the arc a and its twin
+    void disableArc(int32_t a) { disabled[a >> 1] = true; }
+    void enableArc(int32_t a) { disabled[a >> 1] = false; }
+    bool isEnabled(int32_t a) const { return !disabled[a >> 1]; }
+
+    int32_t nodeCount() const { return node_count; }
+    int32_t arcCount() const { return (int32_t) heads.size(); }
+
+    int32_t source(int32_t a) const { return heads[a ^ 1]; }
+    int32_t target(int32_t a) const { return heads[a]; }
+
+    static int32_t twin(int32_t a) { return a ^ 1; }
+    static bool isForward(int32_t a) { return (a & 1) == 0; }
+
+
+    /*
+     * Iterates the enabled out-arcs of a node: first the
+     * ones in the CSR arrays, then the temporary ones
+     */
+    class OutArcIt {
+    public:
+        OutArcIt(const FlowNetwork& net, int32_t v) : net(&net), v(v), pos(net.first_out[v]), end(net.first_out[v + 1]) {
+            arc = (pos < end) ? net.out_arcs[pos] : net.temp_first[v];
+            skipDisabled();
+        }
+
+        OutArcIt& operator++() {
+            next();
+            skipDisabled();
+            return *this;
+        }
+
+        operator int32_t() const { return arc; }
+
+    private:
+        void next() {
+            if (pos < end) {
+                ++pos;
+                arc = (pos < end) ? net->out_arcs[pos] : net->temp_first[v];
+            } else {
+                arc = net->temp_next[arc - net->base_arc_count];
+            }
+        }
+
+        void skipDisabled() {
+            while (arc != INVALID_ARC && net->disabled[arc >> 1]) {
+                next();
+            }
+        }
+
+        const FlowNetwork* net;
+        int32_t v;
+        int32_t pos;
+        int32_t end;
+        int32_t arc;
+    };
+
+
+    /*
+     * Iterates the enabled in-arcs of a node,
+     * the twins of its out-arcs
+     */
+    class InArcIt {
+    public:
+        InArcIt(const FlowNetwork& net, int32_t v) : out(net, v) {}
+
+        InArcIt& operator++() {
+            ++out;
+            return *this;
+        }
+
+        operator int32_t() const {
+            int32_t a = out;
+            return (a == INVALID_ARC) ? INVALID_ARC : twin(a);
+        }
+
+    private:
+        OutArcIt out;
+    };
+
+private:
+    int32_t node_count;
+    int32_t base_arc_count;
+    bool built;
+
+    std::vector<int32_t> heads;      // heads[a] is the target of arc a
+    std::vector<int32_t> first_out;  // out-arcs of v are out_arcs[first_out[v]...first_out[v+1]-1]
+    std::vector<int32_t> out_arcs;
+    std::vector<int32_t> temp_first; // first temporary out-arc of every node
+    std::vector<int32_t> temp_next;  // next temporary out-arc of the same node
+    std::vector<bool> disabled;      // disabled[a >> 1] is true if the pair of a is hidden
+};
+
+#endif //SAFEPATHSRNAPC_FLOW_NETWORK_H
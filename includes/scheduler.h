@@ -0,0 +1,36 @@
+#ifndef SAFEPATHSRNAPC_SCHEDULER_H
+#define SAFEPATHSRNAPC_SCHEDULER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+
+/*
+ * Estimated running time of computing the safe paths (or
+ * safe edges) of a component with the given number of
+ * vertices, edges and width (of the greedy approximation):
+ * there are O(width |V|) safety tests, and every test is a
+ * Max-Flow of O(width) augmenting paths in O(|V| + |E|)
+ */
+double estimate_cost(int64_t nodes, int64_t arcs, int64_t width);
+
+
+
+/*
+ * Runs task(i) for every i in [0, costs.size()) with the
+ * given number of threads (the calling thread is one of
+ * them), where costs[i] is an estimate of the running time
+ * of task(i).
+ *
+ * The tasks are dealt largest first, each to the thread
+ * with the least cost assigned so far. Every thread runs
+ * its tasks from the largest one, and when it has no tasks
+ * left it steals the smallest task of the thread with the
+ * most remaining cost, so a few expensive tasks do not
+ * leave the other threads idle.
+ */
+void run_largest_first(const std::vector<double>& costs, int32_t threads, const std::function<void(size_t)>& task);
+
+#endif //SAFEPATHSRNAPC_SCHEDULER_H
@@ -1,9 +1,16 @@
 #ifndef SAFEPATHSRNAPC_UTILS_H
 #define SAFEPATHSRNAPC_UTILS_H
 
+#include <string>
+
 #include <lemon/list_graph.h>
 
 
-void load_problem_instance(char* filename, lemon::ListDigraph& g, lemon::ListDigraph::NodeMap<int64_t>& original_id, std::vector<lemon::ListDigraph::Node>& S, std::vector<lemon::ListDigraph::Node>& T, std::vector<lemon::ListDigraph::Node>& U);
+/*
+ * Reads a problem instance from a LGF file, or from a
+ * binary instance (see binary_instance.h) if the file
+ * starts with its magic
+ */
+void load_problem_instance(const std::string& filename, lemon::ListDigraph& g, lemon::ListDigraph::NodeMap<int64_t>& original_id, std::vector<lemon::ListDigraph::Node>& S, std::vector<lemon::ListDigraph::Node>& T, std::vector<lemon::ListDigraph::Node>& U);
 
 #endif //SAFEPATHSRNAPC_UTILS_H
@@ -0,0 +1,150 @@
+#include <algorithms/compaction.h>
+
+using namespace lemon;
+
+
+
+CompactedDAG::CompactedDAG(const ListDigraph& original, const std::vector<ListDigraph::Node>& original_S, const std::vector<ListDigraph::Node>& original_T, const std::vector<ListDigraph::Node>& original_U) {
+    ListDigraph::NodeMap<bool> in_S(original, false);
+    ListDigraph::NodeMap<bool> in_T(original, false);
+    ListDigraph::NodeMap<bool> in_U(original, false);
+    for (ListDigraph::Node v: original_S) in_S[v] = true;
+    for (ListDigraph::Node v: original_T) in_T[v] = true;
+    for (ListDigraph::Node v: original_U) in_U[v] = true;
+
+    // next[u] is the vertex following u in its chain (INVALID if u is the last one)
+    ListDigraph::NodeMap<ListDigraph::Node> next(original, INVALID);
+    ListDigraph::NodeMap<bool> is_first(original, true);
+    for (ListDigraph::NodeIt u(original); u != INVALID; ++u) {
+        if (in_T[u] || countOutArcs(original, u) != 1) continue;
+        ListDigraph::Node v = original.target(ListDigraph::OutArcIt(original, u));
+        if (!in_S[v] && countInArcs(original, v) == 1) {
+            next[u] = v;
+            is_first[v] = false;
+        }
+    }
+
+    // Chains without vertices of U are not contracted, a path cover may avoid them and then
+    // their edges are not safe (see expand)
+    for (ListDigraph::NodeIt first(original); first != INVALID; ++first) {
+        if (!is_first[first]) continue;
+        bool covered = false;
+        for (ListDigraph::Node v = first; v != INVALID; v = next[v]) {
+            covered = covered || in_U[v];
+        }
+        if (!covered) {
+            for (ListDigraph::Node v = first; v != INVALID; ) {
+                ListDigraph::Node following = next[v];
+                next[v] = INVALID;
+                if (following != INVALID) is_first[following] = true;
+                v = following;
+            }
+        }
+    }
+
+    // A vertex of g for every chain, in the order of their first vertices
+    ListDigraph::NodeMap<ListDigraph::Node> compacted(original, INVALID);
+    for (ListDigraph::NodeIt first(original); first != INVALID; ++first) {
+        if (!is_first[first]) continue;
+
+        ListDigraph::Node c = g.addNode();
+        chains.resize(g.id(c) + 1);
+        std::vector<ListDigraph::Node>& chain = chains[g.id(c)];
+        bool covered = false;
+        for (ListDigraph::Node v = first; v != INVALID; v = next[v]) {
+            chain.push_back(v);
+            compacted[v] = c;
+            covered = covered || in_U[v];
+        }
+        if (in_S[chain.front()]) S.push_back(c);
+        if (in_T[chain.back()]) T.push_back(c);
+        if (covered) U.push_back(c);
+    }
+
+    // The edges between chains
+    for (ListDigraph::ArcIt e(original); e != INVALID; ++e) {
+        if (next[original.source(e)] != original.target(e)) {
+            g.addArc(compacted[original.source(e)], compacted[original.target(e)]);
+        }
+    }
+}
+
+
+
+std::vector<ListDigraph::Node> CompactedDAG::expand(const std::vector<ListDigraph::Node>& path) const {
+    std::vector<ListDigraph::Node> expanded;
+    for (ListDigraph::Node v: path) {
+        const std::vector<ListDigraph::Node>& vertices = chain(v);
+        expanded.insert(expanded.end(), vertices.begin(), vertices.end());
+    }
+    return expanded;
+}
+
+
+
+std::vector<std::pair<std::vector<ListDigraph::Node>, std::vector<std::vector<ListDigraph::Node>>>> CompactedDAG::expand(const std::vector<std::pair<std::vector<ListDigraph::Node>, std::vector<std::vector<ListDigraph::Node>>>>& safe_paths_per_path) const {
+    std::vector<std::pair<std::vector<ListDigraph::Node>, std::vector<std::vector<ListDigraph::Node>>>> expanded;
+    expanded.reserve(safe_paths_per_path.size());
+    ListDigraph::NodeMap<bool> reported(g, false);
+    for (auto& pair: safe_paths_per_path) {
+        std::vector<std::vector<ListDigraph::Node>> safe_paths;
+        safe_paths.reserve(pair.second.size());
+        for (auto& safe_path: pair.second) {
+            safe_paths.push_back(expand(safe_path));
+            for (ListDigraph::Node v: safe_path) {
+                reported[v] = true;
+            }
+        }
+
+        // A contracted chain has a vertex of U, so every path cover traverses it and its
+        // edges are safe, even if the chain alone (a path without edges in g) is not reported
+        for (ListDigraph::Node v: pair.first) {
+            if (!reported[v] && chain(v).size() > 1) {
+                safe_paths.push_back(chain(v));
+                reported[v] = true;
+            }
+        }
+        expanded.emplace_back(expand(pair.first), std::move(safe_paths));
+    }
+    return expanded;
+}
+
+
+
+void CompactedDAG::expand(const SafePathSet& safe_paths, SafePathSet& expanded) const {
+    std::vector<std::vector<size_t>> safe_paths_of_path(safe_paths.pathCount());
+    for (size_t k = 0; k < safe_paths.safePathCount(); ++k) {
+        safe_paths_of_path[safe_paths.intervals()[k].path].push_back(k);
+    }
+
+    ListDigraph::NodeMap<bool> reported(g, false);
+    std::vector<size_t> offset;
+    for (size_t i = 0; i < safe_paths.pathCount(); ++i) {
+        PathView path = safe_paths.path(i);
+
+        // offset[z] is the position of the chain of path[z] in the expanded path
+        offset.assign(1, 0);
+        std::vector<ListDigraph::Node> expanded_path;
+        for (ListDigraph::Node v: path) {
+            expanded_path.insert(expanded_path.end(), chain(v).begin(), chain(v).end());
+            offset.push_back(expanded_path.size());
+        }
+        size_t expanded_i = expanded.addPath(expanded_path.begin(), expanded_path.end());
+
+        for (size_t k: safe_paths_of_path[i]) {
+            const SafePathInterval& safe_path = safe_paths.intervals()[k];
+            expanded.addSafePath(expanded_i, offset[safe_path.x], offset[safe_path.y + 1] - 1);
+            for (size_t z = safe_path.x; z <= safe_path.y; ++z) {
+                reported[path[z]] = true;
+            }
+        }
+
+        // The contracted chains that are not part of a safe path (see above)
+        for (size_t z = 0; z < path.size(); ++z) {
+            if (!reported[path[z]] && chain(path[z]).size() > 1) {
+                expanded.addSafePath(expanded_i, offset[z], offset[z + 1] - 1);
+                reported[path[z]] = true;
+            }
+        }
+    }
+}
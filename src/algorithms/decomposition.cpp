@@ -0,0 +1,94 @@
+#include <algorithms/decomposition.h>
+
+#include <algorithms/top_sort.h>
+
+#include <algorithm>
+
+using namespace lemon;
+
+
+
+std::vector<int32_t> find_cut_vertices(ListDigraph& g, std::vector<ListDigraph::Node>& S, std::vector<ListDigraph::Node>& T, std::vector<ListDigraph::Node>& order) {
+    order = topological_sort(g);
+    int32_t n = (int32_t) order.size();
+
+    ListDigraph::NodeMap<int32_t> position(g);
+    for (int32_t p = 0; p < n; ++p) {
+        position[order[p]] = p;
+    }
+
+    // The cut vertices are between the last vertex of S and the first vertex of T
+    int32_t last_S = 0;
+    for (ListDigraph::Node v: S) {
+        last_S = std::max(last_S, position[v]);
+    }
+    int32_t first_T = n - 1;
+    for (ListDigraph::Node v: T) {
+        first_T = std::min(first_T, position[v]);
+    }
+
+    // jumps[p] is the number of edges u -> v with position[u] < p < position[v]
+    std::vector<int32_t> jumps(n + 1, 0);
+    for (ListDigraph::ArcIt e(g); e != INVALID; ++e) {
+        ++jumps[position[g.source(e)] + 1];
+        --jumps[position[g.target(e)]];
+    }
+
+    std::vector<int32_t> cuts;
+    int32_t jumping = 0;
+    for (int32_t p = 0; p < n - 1; ++p) {
+        jumping += jumps[p];
+        if (p > 0 && p >= last_S && p <= first_T && jumping == 0) {
+            cuts.push_back(p);
+        }
+    }
+    return cuts;
+}
+
+
+
+SubProblem::SubProblem(const ListDigraph& original_g, const std::vector<ListDigraph::Node>& order, const ListDigraph::NodeMap<int32_t>& position, const std::vector<bool>& in_S, const std::vector<bool>& in_T, const std::vector<bool>& in_U, int32_t first, int32_t last) {
+    // The vertex order[p] is the vertex p - first of g
+    for (int32_t p = first; p <= last; ++p) {
+        g.addNode();
+        vertices.push_back(order[p]);
+    }
+    for (int32_t p = first; p <= last; ++p) {
+        for (ListDigraph::OutArcIt e(original_g, order[p]); e != INVALID; ++e) {
+            int32_t target = position[original_g.target(e)];
+            if (target <= last) { // The edges go forward in the order
+                g.addArc(g.nodeFromId(p - first), g.nodeFromId(target - first));
+            }
+        }
+    }
+
+    for (int32_t p = first + 1; p <= last; ++p) {
+        if (in_S[p]) S.push_back(g.nodeFromId(p - first));
+    }
+    S.push_back(g.nodeFromId(0));
+    for (int32_t p = first; p < last; ++p) {
+        if (in_T[p]) T.push_back(g.nodeFromId(p - first));
+    }
+    T.push_back(g.nodeFromId(last - first));
+    // Every path of g passes through the cut vertices
+    for (int32_t p = first + 1; p < last; ++p) {
+        if (in_U[p]) U.push_back(g.nodeFromId(p - first));
+    }
+    if (first > 0 || in_U[first]) {
+        U.push_back(g.nodeFromId(0));
+    }
+    if (last < (int32_t) order.size() - 1 || in_U[last]) {
+        U.push_back(g.nodeFromId(last - first));
+    }
+}
+
+
+
+std::vector<ListDigraph::Node> SubProblem::original(const std::vector<ListDigraph::Node>& path) const {
+    std::vector<ListDigraph::Node> original_path;
+    original_path.reserve(path.size());
+    for (ListDigraph::Node v: path) {
+        original_path.push_back(original(v));
+    }
+    return original_path;
+}
@@ -1,94 +1,377 @@
 #include <algorithms/filter_paths.h>
 
-#include <qsufsort.hpp>
-#include <unordered_map>
+#include <algorithm>
+
 
 using namespace lemon;
 
-std::vector<std::vector<ListDigraph::Node>> filter_contained_paths(ListDigraph& g, std::vector<std::pair<std::vector<ListDigraph::Node>,std::vector<std::vector<ListDigraph::Node>>>>& safe_paths_per_path) {
-    if (safe_paths_per_path.size() == 0) return {};
 
-    std::vector<std::vector<ListDigraph::Node>> safe_paths;
+
+// Trie of the safe paths (as strings of vertex ids) with the suffix links of the Aho-Corasick automaton,
+// the children of a state are out-neighbours of its last vertex, so they are kept in a (short) list,
+// but the children of the root are indexed by vertex id
+struct PathTrie {
+    std::vector<int> id;                // Vertex id of the last vertex of every state
+    std::vector<size_t> first_child;    // 0 if it has no children (the root is the state 0)
+    std::vector<size_t> next_sibling;   // 0 if it is the last child
+    std::vector<size_t> link;
+    std::vector<size_t> bfs_order;
+    std::vector<size_t> root_child;     // By vertex id
+
+    PathTrie(size_t length, size_t ids) : root_child(ids, 0) {
+        id.reserve(length + 1);
+        first_child.reserve(length + 1);
+        next_sibling.reserve(length + 1);
+        link.reserve(length + 1);
+        add_state(-1);
+    }
+
+    size_t add_state(int vertex_id) {
+        id.push_back(vertex_id);
+        first_child.push_back(0);
+        next_sibling.push_back(0);
+        link.push_back(0);
+        return id.size() - 1;
+    }
+
+    // The child of state by vertex_id, 0 if there is none
+    size_t next(size_t state, int vertex_id) const {
+        if (state == 0) {
+            return root_child[vertex_id];
+        }
+        size_t child = first_child[state];
+        while (child != 0 && id[child] != vertex_id) {
+            child = next_sibling[child];
+        }
+        return child;
+    }
+};
+
+
+
+// Adds the path to the trie and returns its state
+static size_t insert_path(ListDigraph& g, PathTrie& trie, const std::vector<ListDigraph::Node>& path) {
+    size_t state = 0;
+    for (ListDigraph::Node v: path) {
+        size_t child = trie.next(state, g.id(v));
+        if (child == 0) {
+            child = trie.add_state(g.id(v));
+            trie.next_sibling[child] = trie.first_child[state];
+            trie.first_child[state] = child;
+            if (state == 0) {
+                trie.root_child[g.id(v)] = child;
+            }
+        }
+        state = child;
+    }
+    return state;
+}
+
+
+
+// Computes the suffix links in BFS order of the trie, where the link of a state is the
+// state of its longest proper suffix in the trie (as in the Aho-Corasick automaton)
+static void compute_suffix_links(PathTrie& trie) {
+    trie.bfs_order.reserve(trie.id.size());
+    trie.bfs_order.push_back(0);
+    for (size_t i = 0; i < trie.bfs_order.size(); ++i) {
+        size_t state = trie.bfs_order[i];
+        for (size_t child = trie.first_child[state]; child != 0; child = trie.next_sibling[child]) {
+            if (state != 0) {
+                size_t suffix = trie.link[state];
+                while (suffix != 0 && trie.next(suffix, trie.id[child]) == 0) {
+                    suffix = trie.link[suffix];
+                }
+                trie.link[child] = trie.next(suffix, trie.id[child]);
+            }
+            trie.bfs_order.push_back(child);
+        }
+    }
+}
+
+
+
+// Paths of the path cover, by reference
+typedef std::vector<PathView> PathCover;
+
+
+
+// Filters the safe paths with the trie, for safe paths that are not subpaths of the paths of the path cover
+static std::vector<std::vector<ListDigraph::Node>> filter_contained_paths_trie(ListDigraph& g, std::vector<std::pair<std::vector<ListDigraph::Node>,std::vector<std::vector<ListDigraph::Node>>>>& safe_paths_per_path) {
+    std::vector<const std::vector<ListDigraph::Node>*> safe_paths;
+    size_t length = 0;
     for (auto& pair: safe_paths_per_path) {
-        std::vector<std::vector<ListDigraph::Node>> &paths = pair.second;
-        for (auto path: paths) {
-            safe_paths.push_back(path);
+        for (auto& path: pair.second) {
+            safe_paths.push_back(&path);
+            length += path.size();
         }
     }
+    if (safe_paths.empty()) return {};
+
+    PathTrie trie(length, g.maxNodeId() + 1);
+
+    std::vector<size_t> state_of_path;
+    state_of_path.reserve(safe_paths.size());
+    for (auto path: safe_paths) {
+        state_of_path.push_back(insert_path(g, trie, *path));
+    }
+    compute_suffix_links(trie);
 
-    int n = 1;
-    int s = 0;
-    int max_id = -1;
-    int min_id = countNodes(g);
+    // A path is contained in another one if it is a proper prefix of a path (its state has
+    // children), or a suffix of such a prefix or of another path (its state is reached from
+    // one of these by suffix links)
+    std::vector<bool> contained(trie.id.size(), false);
+    for (size_t state = 0; state < trie.id.size(); ++state) {
+        contained[state] = trie.first_child[state] != 0;
+    }
+    for (size_t state: state_of_path) {
+        contained[trie.link[state]] = true;
+    }
+    for (auto it = trie.bfs_order.rbegin(); it != trie.bfs_order.rend(); ++it) {
+        if (contained[*it]) {
+            contained[trie.link[*it]] = true;
+        }
+    }
 
-    std::unordered_map<int,int> start_to_path;
-    for (auto& path: safe_paths) {
-        start_to_path[n] = s;
-        for (ListDigraph::Node v: path) {
-            int id = g.id(v) + 2;
-            max_id = (id > max_id) ? id : max_id;
-            min_id = (id < min_id) ? id : min_id;
-            ++n;
+    // Only the first copy of a repeated path is reported
+    std::vector<std::vector<ListDigraph::Node>> filtered_safe_paths;
+    std::vector<bool> reported(trie.id.size(), false);
+    for (size_t i = 0; i < safe_paths.size(); ++i) {
+        size_t state = state_of_path[i];
+        if (state != 0 && !contained[state] && !reported[state]) {
+            reported[state] = true;
+            filtered_safe_paths.push_back(*safe_paths[i]);
         }
-        ++n;
-        ++s;
     }
 
+    return filtered_safe_paths;
+}
+
 
 
-    int* array = new int[n+1];
-    array[n] = 0;
-    int* copy_array = new int[n+1];
-    int j = 0;
-    array[j++] = min_id-1;
+// Polynomial hashes of the prefixes of every path of the path cover, to compare subpaths in O(1)
+struct PathHashes {
+    static constexpr uint64_t BASE = 0x100000001b3ULL;
+    std::vector<size_t> first; // The prefixes of path i are prefix[first[i]...first[i+1]-1]
+    std::vector<uint64_t> prefix;
+    std::vector<uint64_t> power;
 
-    for (auto& path: safe_paths) {
-        for (ListDigraph::Node v: path) {
-            int id = g.id(v) + 2;
-            array[j++] = id;
+    PathHashes(ListDigraph& g, const PathCover& path_cover) : first(1, 0), power(1, 1) {
+        size_t length = 0;
+        for (PathView path: path_cover) {
+            length += path.size() + 1;
+        }
+        prefix.reserve(length);
+        for (PathView path: path_cover) {
+            prefix.push_back(0);
+            for (ListDigraph::Node v: path) {
+                prefix.push_back(prefix.back() * BASE + (uint64_t) g.id(v) + 1);
+            }
+            first.push_back(prefix.size());
+            while (power.size() <= path.size()) {
+                power.push_back(power.back() * BASE);
+            }
         }
-        array[j++] = min_id-1;
     }
 
+    // Hash of path_cover[path][x...y]
+    uint64_t hash(size_t path, size_t x, size_t y) const {
+        return prefix[first[path] + y + 1] - prefix[first[path] + x] * power[y - x + 1];
+    }
+};
+
 
 
-    for (int i = 0; i < n+1; ++i) {
-        copy_array[i] = array[i];
+// Intervals of every path of the path cover sorted by x, with the largest y of every prefix of them
+struct PathIntervals {
+    std::vector<size_t> first; // The intervals of path i are first[i]...first[i+1]-1
+    std::vector<size_t> x;
+    std::vector<size_t> max_y;
+
+    PathIntervals(const PathCover& path_cover, const std::vector<SafePathInterval>& safe_paths) : first(path_cover.size() + 1, 0), x(safe_paths.size()), max_y(safe_paths.size()) {
+        for (const SafePathInterval& safe_path: safe_paths) {
+            ++first[safe_path.path + 1];
+        }
+        for (size_t i = 0; i < path_cover.size(); ++i) {
+            first[i + 1] += first[i];
+        }
+        std::vector<std::pair<size_t, size_t>> intervals(safe_paths.size());
+        std::vector<size_t> next(first.begin(), first.end() - 1);
+        for (const SafePathInterval& safe_path: safe_paths) {
+            intervals[next[safe_path.path]++] = {safe_path.x, safe_path.y};
+        }
+        for (size_t i = 0; i < path_cover.size(); ++i) {
+            std::sort(intervals.begin() + first[i], intervals.begin() + first[i + 1]);
+            for (size_t k = first[i]; k < first[i + 1]; ++k) {
+                x[k] = intervals[k].first;
+                max_y[k] = (k == first[i]) ? intervals[k].second : std::max(max_y[k - 1], intervals[k].second);
+            }
+        }
     }
 
-    int* sa = new int[n+1];
+    // True if an interval of the path other than [a, b] contains [a, b]
+    bool strictly_contains(size_t path, size_t a, size_t b) const {
+        auto begin = x.begin() + first[path], end = x.begin() + first[path + 1];
+        size_t before = std::lower_bound(begin, end, a) - x.begin(); // Intervals with x < a
+        size_t until = std::upper_bound(begin, end, a) - x.begin();  // Intervals with x <= a
+        return (before > first[path] && max_y[before - 1] >= b) || (until > first[path] && max_y[until - 1] > b);
+    }
+};
 
-    qsufsort qss;
-    qss.suffixsort(copy_array, sa, n, max_id+1, min_id-1);
 
-    std::vector<std::vector<ListDigraph::Node>> filtered_safe_paths;
-    std::vector<bool> reported(s, false);
-    for (int i = 0; i < safe_paths.size(); ++i) {
-        std::vector<ListDigraph::Node>& path = safe_paths[i];
-        if (!reported[i]) {
-            bool report = true;
-            std::vector<int> path_ids;
+
+static bool equal_subpaths(const PathCover& path_cover, const SafePathInterval& a, size_t path, size_t x) {
+    return std::equal(path_cover[a.path].begin() + a.x, path_cover[a.path].begin() + a.y + 1, path_cover[path].begin() + x);
+}
+
+
+
+// Marks the safe paths reported by filter_contained_intervals
+static std::vector<bool> filter_intervals(ListDigraph& g, const PathCover& path_cover, const std::vector<SafePathInterval>& safe_paths, size_t chunk_size) {
+    PathHashes hashes(g, path_cover);
+    PathIntervals intervals(path_cover, safe_paths);
+
+    // The safe paths by the id of their first vertex (in their order), every chunk is a range of ids
+    size_t ids = g.maxNodeId() + 1;
+    std::vector<size_t> first_path(ids + 1, 0);
+    for (const SafePathInterval& safe_path: safe_paths) {
+        ++first_path[g.id(path_cover[safe_path.path][safe_path.x]) + 1];
+    }
+    for (size_t id = 0; id < ids; ++id) {
+        first_path[id + 1] += first_path[id];
+    }
+    std::vector<size_t> paths_by_start(safe_paths.size());
+    std::vector<size_t> next_path(first_path.begin(), first_path.end() - 1);
+    for (size_t i = 0; i < safe_paths.size(); ++i) {
+        paths_by_start[next_path[g.id(path_cover[safe_paths[i].path][safe_paths[i].x])]++] = i;
+    }
+    if (chunk_size == 0) {
+        chunk_size = safe_paths.size();
+    }
+
+    std::vector<bool> reported(safe_paths.size(), false);
+    size_t chunk_begin = 0;
+    while (chunk_begin < ids) {
+        size_t chunk_end = chunk_begin + 1;
+        while (chunk_end < ids && first_path[chunk_end + 1] - first_path[chunk_begin] <= chunk_size) {
+            ++chunk_end;
+        }
+
+        // Positions in the paths of the path cover (at most one per path, as g is a DAG) of the
+        // vertices of the chunk starting a safe path
+        std::vector<size_t> first_position(chunk_end - chunk_begin + 1, 0);
+        for (PathView path: path_cover) {
             for (ListDigraph::Node v: path) {
-                path_ids.push_back(g.id(v)+2);
+                size_t id = g.id(v);
+                if (id >= chunk_begin && id < chunk_end && first_path[id] != first_path[id + 1]) ++first_position[id - chunk_begin + 1];
+            }
+        }
+        for (size_t id = 0; id + chunk_begin < chunk_end; ++id) {
+            first_position[id + 1] += first_position[id];
+        }
+        std::vector<std::pair<size_t, size_t>> positions(first_position.back()); // Path and position
+        std::vector<size_t> next_position(first_position.begin(), first_position.end() - 1);
+        for (size_t i = 0; i < path_cover.size(); ++i) {
+            for (size_t z = 0; z < path_cover[i].size(); ++z) {
+                size_t id = g.id(path_cover[i][z]);
+                if (id >= chunk_begin && id < chunk_end && first_path[id] != first_path[id + 1]) positions[next_position[id - chunk_begin]++] = {i, z};
             }
+        }
 
-            for (int j : qss.locate(path_ids, array, n, sa)) {
-                if (array[j-1] == min_id-1 && array[j+path.size()] == min_id-1) {
-                    reported[start_to_path[j]] = true;
-                } else {
-                    report = false;
+        // A safe path is contained in another one if that one spans it in a path of the path cover,
+        // every occurrence of the safe path in a path starts at the position of its first vertex
+        for (size_t id = chunk_begin; id < chunk_end; ++id) {
+            std::vector<std::pair<uint64_t, size_t>> reported_from_id; // Hash and position
+            for (size_t k = first_path[id]; k < first_path[id + 1]; ++k) {
+                const SafePathInterval& safe_path = safe_paths[paths_by_start[k]];
+                size_t length = safe_path.y - safe_path.x + 1;
+                uint64_t hash = hashes.hash(safe_path.path, safe_path.x, safe_path.y);
+
+                bool contained = false;
+                for (size_t p = first_position[id - chunk_begin]; p < first_position[id - chunk_begin + 1] && !contained; ++p) {
+                    size_t path = positions[p].first;
+                    size_t x = positions[p].second;
+                    size_t y = x + length - 1;
+                    contained = y < path_cover[path].size()
+                        && hashes.hash(path, x, y) == hash
+                        && intervals.strictly_contains(path, x, y)
+                        && equal_subpaths(path_cover, safe_path, path, x);
                 }
-            }
+                if (contained) continue;
 
-            if (report) {
-                filtered_safe_paths.push_back(path);
+                // Only the first copy of a repeated path is reported, the copies start at the same vertex
+                bool repeated = false;
+                for (auto& copy: reported_from_id) {
+                    const SafePathInterval& copy_path = safe_paths[copy.second];
+                    repeated = repeated || (copy.first == hash && copy_path.y - copy_path.x + 1 == length && equal_subpaths(path_cover, safe_path, copy_path.path, copy_path.x));
+                }
+                if (!repeated) {
+                    reported_from_id.emplace_back(hash, paths_by_start[k]);
+                    reported[paths_by_start[k]] = true;
+                }
             }
         }
+        chunk_begin = chunk_end;
+    }
+
+    return reported;
+}
+
+
+
+std::vector<SafePathInterval> filter_contained_intervals(ListDigraph& g, const std::vector<std::vector<ListDigraph::Node>>& path_cover, const std::vector<SafePathInterval>& safe_paths, size_t chunk_size) {
+    PathCover paths(path_cover.begin(), path_cover.end());
+
+    std::vector<bool> reported = filter_intervals(g, paths, safe_paths, chunk_size);
+    std::vector<SafePathInterval> filtered_safe_paths;
+    for (size_t i = 0; i < safe_paths.size(); ++i) {
+        if (reported[i]) filtered_safe_paths.push_back(safe_paths[i]);
     }
+    return filtered_safe_paths;
+}
+
+
+
+std::vector<std::vector<ListDigraph::Node>> filter_contained_paths(ListDigraph& g, std::vector<std::pair<std::vector<ListDigraph::Node>,std::vector<std::vector<ListDigraph::Node>>>>& safe_paths_per_path, size_t chunk_size) {
+    if (safe_paths_per_path.size() == 0) return {};
 
-    delete [] array;
-    delete [] copy_array;
-    delete [] sa;
+    // The coordinates of the safe paths in the paths of the path cover they come from
+    PathCover path_cover;
+    std::vector<SafePathInterval> safe_paths;
+    std::vector<size_t> position(g.maxNodeId() + 1, 0);
+    for (auto& pair: safe_paths_per_path) {
+        size_t i = path_cover.size();
+        path_cover.push_back(pair.first);
+        for (size_t z = 0; z < pair.first.size(); ++z) {
+            position[g.id(pair.first[z])] = z;
+        }
+        for (auto& path: pair.second) {
+            if (path.empty()) continue;
+            size_t x = position[g.id(path.front())];
+            if (x + path.size() > pair.first.size() || !std::equal(path.begin(), path.end(), pair.first.begin() + x)) {
+                return filter_contained_paths_trie(g, safe_paths_per_path);
+            }
+            safe_paths.push_back({i, x, x + path.size() - 1});
+        }
+    }
 
+    std::vector<bool> reported = filter_intervals(g, path_cover, safe_paths, chunk_size);
+    std::vector<std::vector<ListDigraph::Node>> filtered_safe_paths;
+    for (size_t i = 0; i < safe_paths.size(); ++i) {
+        if (reported[i]) {
+            const SafePathInterval& safe_path = safe_paths[i];
+            filtered_safe_paths.push_back(path_cover[safe_path.path].subpath(safe_path.x, safe_path.y).toVector());
+        }
+    }
     return filtered_safe_paths;
-}
\ No newline at end of file
+}
+
+
+
+void filter_contained_paths(ListDigraph& g, SafePathSet& safe_paths, size_t chunk_size) {
+    PathCover path_cover;
+    for (size_t i = 0; i < safe_paths.pathCount(); ++i) {
+        path_cover.push_back(safe_paths.path(i));
+    }
+    safe_paths.filterSafePaths(filter_intervals(g, path_cover, safe_paths.intervals(), chunk_size));
+}
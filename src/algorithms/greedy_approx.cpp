@@ -1,575 +1,214 @@
 #include <algorithms/greedy_approx.h>
 #include <algorithms/top_sort.h>
 
+#include <algorithm>
+#include <queue>
+
 using namespace lemon;
 
 
 
-std::vector<std::vector<ListDigraph::Node>> greedy_approximation_MPC(ListDigraph& g) {
+// Greedy approximation covering U (every vertex if U is null) with paths starting at S and
+// ending at T (every vertex if null). Every path is a path covering the maximum number of
+// uncovered vertices, found by a dynamic programming over the reverse topological order.
+// After extracting a path, only the ancestors of its newly covered vertices can change their
+// DP values, so only those are recomputed (stopping at the vertices whose value is unchanged)
+static void greedy_approximation(ListDigraph& g, std::vector<ListDigraph::Node>* S, std::vector<ListDigraph::Node>* T, std::vector<ListDigraph::Node>* U, std::vector<std::vector<ListDigraph::Node>>& path_cover, std::vector<std::vector<ListDigraph::Arc>>& path_cover_edges) {
 
-    std::vector<std::vector<ListDigraph::Node>> path_cover;
     std::vector<ListDigraph::Node> top_order = topological_sort(g);
+    if (top_order.empty()) {
+        return;
+    }
 
-    int64_t n = countNodes(g);
-    int64_t covered_vertices = 0;
-    ListDigraph::NodeMap<bool> covered(g, false);
-
-    while (covered_vertices < n) {
-        int64_t max_length = 0;
-        ListDigraph::Node max_length_source = top_order[0];
+    ListDigraph::NodeMap<int32_t> position(g);
+    for (int32_t i = 0; i < (int32_t) top_order.size(); ++i) {
+        position[top_order[i]] = i;
+    }
 
-        ListDigraph::NodeMap<int64_t> max_length_from_vertex(g);
-        ListDigraph::NodeMap<ListDigraph::Node> next_max_length_from_vertex(g);
-        for (ListDigraph::Node v : top_order) {
-            max_length_from_vertex[v] = ((covered[v]) ? 0 : 1);
-            next_max_length_from_vertex[v] = v;
+    int64_t to_cover = (U == nullptr) ? countNodes(g) : U->size();
+    int64_t covered_vertices = 0;
+    ListDigraph::NodeMap<bool> covered(g, U != nullptr); // Set as false only the vertices in U
+    if (U != nullptr) {
+        for (ListDigraph::Node v : *U) {
+            covered[v] = false;
         }
+    }
 
-        for (std::vector<ListDigraph::Node>::reverse_iterator rit = top_order.rbegin(); rit != top_order.rend(); ++rit) {
-            ListDigraph::Node u = *rit;
-            int64_t max = 0;
-            for (ListDigraph::OutArcIt e(g, u); e != INVALID; ++e) {
-                ListDigraph::Node v = g.target(e);
-                int64_t max_v = max_length_from_vertex[v];
-                if (max_v > max) {
-                    max = max_v;
-                    next_max_length_from_vertex[u] = v;
-                }
-            }
-
-            max_length_from_vertex[u] = max + max_length_from_vertex[u];
-            if (max_length_from_vertex[u] > max_length) {
-                max_length = max_length_from_vertex[u];
-                max_length_source = u;
-            }
+    ListDigraph::NodeMap<bool> in_S(g, S == nullptr);
+    ListDigraph::NodeMap<bool> in_T(g, T == nullptr);
+    if (S != nullptr) {
+        for (ListDigraph::Node v : *S) {
+            in_S[v] = true;
         }
-
-        std::vector<ListDigraph::Node> path;
-        ListDigraph::Node v = max_length_source;
-        while (true) {
-            if (!covered[v]) {
-                covered[v] = true;
-                ++covered_vertices;
-            }
-            path.push_back(v);
-            if (v == next_max_length_from_vertex[v]) break;
-            v = next_max_length_from_vertex[v];
-        }
-
-        path_cover.push_back(path);
     }
-
-    return path_cover;
-}
-
-
-
-std::vector<std::vector<ListDigraph::Arc>> greedy_approximation_MPC_edges(ListDigraph& g) {
-
-    std::vector<std::vector<ListDigraph::Arc>> path_cover;
-    std::vector<ListDigraph::Node> top_order = topological_sort(g);
-
-    int64_t n = countNodes(g);
-    int64_t covered_vertices = 0;
-    ListDigraph::NodeMap<bool> covered(g, false);
-
-    while (covered_vertices < n) {
-        int64_t max_length = 0;
-        ListDigraph::Node max_length_source = top_order[0];
-
-        ListDigraph::NodeMap<int64_t> max_length_from_vertex(g);
-        ListDigraph::NodeMap<ListDigraph::Node> next_max_length_from_vertex(g);
-        ListDigraph::NodeMap<ListDigraph::Arc> next_max_length_from_edges(g);
-
-        for (ListDigraph::Node v : top_order) {
-            max_length_from_vertex[v] = ((covered[v]) ? 0 : 1);
-            next_max_length_from_vertex[v] = v;
+    if (T != nullptr) {
+        for (ListDigraph::Node v : *T) {
+            in_T[v] = true;
         }
+    }
 
-        for (std::vector<ListDigraph::Node>::reverse_iterator rit = top_order.rbegin(); rit != top_order.rend(); ++rit) {
-            ListDigraph::Node u = *rit;
-            int64_t max = 0;
-            for (ListDigraph::OutArcIt e(g, u); e != INVALID; ++e) {
-                ListDigraph::Node v = g.target(e);
-                int64_t max_v = max_length_from_vertex[v];
-                if (max_v > max) {
-                    max = max_v;
-                    next_max_length_from_vertex[u] = v;
-                    next_max_length_from_edges[u] = e;
-                }
-            }
+    ListDigraph::NodeMap<int64_t> max_length_from_vertex(g, 0);
+    ListDigraph::NodeMap<ListDigraph::Node> next_max_length_from_vertex(g);
+    ListDigraph::NodeMap<ListDigraph::Arc> next_max_length_from_edges(g, INVALID);
 
-            max_length_from_vertex[u] = max + max_length_from_vertex[u];
-            if (max_length_from_vertex[u] > max_length) {
-                max_length = max_length_from_vertex[u];
-                max_length_source = u;
+    // Recomputes the DP at u from its out-neighbors, returns if its value changed
+    auto update = [&](ListDigraph::Node u) {
+        int64_t length_u = covered[u] ? 0 : 1;
+        int64_t max = -1;
+        next_max_length_from_vertex[u] = u;
+        next_max_length_from_edges[u] = INVALID;
+        for (ListDigraph::OutArcIt e(g, u); e != INVALID; ++e) {
+            ListDigraph::Node v = g.target(e);
+            int64_t max_v = max_length_from_vertex[v];
+            if (max_v > max) {
+                max = max_v;
+                next_max_length_from_vertex[u] = v;
+                next_max_length_from_edges[u] = e;
             }
         }
 
-        std::vector<ListDigraph::Arc> path;
-        ListDigraph::Node v = max_length_source;
-        ListDigraph::Arc e(INVALID);
-        while (true) {
-            if (!covered[v]) {
-                covered[v] = true;
-                ++covered_vertices;
-            }
-            if (g.valid(next_max_length_from_edges[v]))
-                path.push_back(next_max_length_from_edges[v]);
-            if (v == next_max_length_from_vertex[v]) break;
-            v = next_max_length_from_vertex[v];
-            e = next_max_length_from_edges[v];
+        int64_t max_length = std::max(length_u + max, (in_T[u]) ? length_u : 0);
+        if (in_T[u] && length_u == max_length) {
+            next_max_length_from_vertex[u] = u;
+            next_max_length_from_edges[u] = INVALID;
         }
+        bool changed = max_length != max_length_from_vertex[u];
+        max_length_from_vertex[u] = max_length;
+        return changed;
+    };
 
-        path_cover.push_back(path);
-    }
-
-    return path_cover;
-}
-
-
-
-std::vector<std::vector<ListDigraph::Node>> greedy_approximation_MPC(ListDigraph& g, std::vector<ListDigraph::Node>& S, std::vector<ListDigraph::Node>& T) {
-
-    std::vector<std::vector<ListDigraph::Node>> path_cover;
-    std::vector<ListDigraph::Node> top_order = topological_sort(g);
-
-    int64_t n = countNodes(g);
-    int64_t covered_vertices = 0;
-    ListDigraph::NodeMap<bool> covered(g, false);
-
-    ListDigraph::NodeMap<bool> in_T(g, false);
-    ListDigraph::NodeMap<bool> in_S(g, false);
-    for (ListDigraph::Node v : T) {
-        in_T[v] = true;
-    }
-    for (ListDigraph::Node v : S) {
-        in_S[v] = true;
+    // Candidate starting vertices as {length, position}, the ties are broken by the last
+    // position in the topological order. Entries whose length is outdated are skipped
+    std::priority_queue<std::pair<int64_t, int32_t>> sources;
+    for (std::vector<ListDigraph::Node>::reverse_iterator rit = top_order.rbegin(); rit != top_order.rend(); ++rit) {
+        update(*rit);
+        if (in_S[*rit]) {
+            sources.push({max_length_from_vertex[*rit], position[*rit]});
+        }
     }
 
+    // Vertices to recompute, by decreasing position in the topological order
+    std::priority_queue<int32_t> pending;
+    ListDigraph::NodeMap<bool> is_pending(g, false);
 
-    while (covered_vertices < n) {
-        int64_t max_length = 0;
-        ListDigraph::Node max_length_source = top_order[0];
-
-        ListDigraph::NodeMap<int64_t> max_length_from_vertex(g);
-        ListDigraph::NodeMap<ListDigraph::Node> next_max_length_from_vertex(g);
-        for (ListDigraph::Node v : top_order) {
-            max_length_from_vertex[v] = ((covered[v]) ? 0 : (in_T[v]) ? 1 : 0);
-            next_max_length_from_vertex[v] = v;
+    while (covered_vertices < to_cover) {
+        while (!sources.empty() && sources.top().first != max_length_from_vertex[top_order[sources.top().second]]) {
+            sources.pop();
         }
-
-        for (std::vector<ListDigraph::Node>::reverse_iterator rit = top_order.rbegin(); rit != top_order.rend(); ++rit) {
-            ListDigraph::Node u = *rit;
-            int64_t max = -1;
-            for (ListDigraph::OutArcIt e(g, u); e != INVALID; ++e) {
-                ListDigraph::Node v = g.target(e);
-                int64_t max_v = max_length_from_vertex[v];
-                if (max_v > max) {
-                    max = max_v;
-                    next_max_length_from_vertex[u] = v;
-                }
-            }
-
-            max_length_from_vertex[u] = ((covered[u] ? 0 : 1) + max > max_length_from_vertex[u]) ? (covered[u] ? 0 : 1) + max : max_length_from_vertex[u];
-            if (in_T[u] && ((covered[u] ? 0 : 1) == max_length_from_vertex[u])) {
-                next_max_length_from_vertex[u] = u;
-            }
-            if (max_length_from_vertex[u] > max_length && in_S[u]) {
-                max_length = max_length_from_vertex[u];
-                max_length_source = u;
-            }
+        ListDigraph::Node max_length_source = top_order[0];
+        if (!sources.empty() && sources.top().first > 0) {
+            max_length_source = top_order[sources.top().second];
         }
 
         std::vector<ListDigraph::Node> path;
+        std::vector<ListDigraph::Arc> path_edges;
         ListDigraph::Node v = max_length_source;
         while (true) {
             if (!covered[v]) {
                 covered[v] = true;
                 ++covered_vertices;
+                pending.push(position[v]);
+                is_pending[v] = true;
             }
             path.push_back(v);
+            if (next_max_length_from_edges[v] != INVALID)
+                path_edges.push_back(next_max_length_from_edges[v]);
             if (v == next_max_length_from_vertex[v]) break;
             v = next_max_length_from_vertex[v];
         }
 
         path_cover.push_back(path);
-    }
-
-    return path_cover;
-}
-
-
-
-std::vector<std::vector<ListDigraph::Arc>> greedy_approximation_MPC_edges(ListDigraph& g, std::vector<ListDigraph::Node>& S, std::vector<ListDigraph::Node>& T) {
-
-    ListDigraph::Arc null_edge(INVALID);
-    std::vector<std::vector<ListDigraph::Arc>> path_cover;
-    std::vector<ListDigraph::Node> top_order = topological_sort(g);
-
-    int64_t n = countNodes(g);
-    int64_t covered_vertices = 0;
-    ListDigraph::NodeMap<bool> covered(g, false);
-
-    ListDigraph::NodeMap<bool> in_T(g, false);
-    ListDigraph::NodeMap<bool> in_S(g, false);
-
-    for (ListDigraph::Node v : T) {
-        in_T[v] = true;
-    }
-    for (ListDigraph::Node v : S) {
-        in_S[v] = true;
-    }
-
-
-    while (covered_vertices < n) {
-        int64_t max_length = 0;
-        ListDigraph::Node max_length_source = top_order[0];
-
-        ListDigraph::NodeMap<int64_t> max_length_from_vertex(g);
-        ListDigraph::NodeMap<ListDigraph::Node> next_max_length_from_vertex(g);
-        ListDigraph::NodeMap<ListDigraph::Arc> next_max_length_from_edges(g, null_edge);
-
-        for (ListDigraph::Node v : top_order) {
-            max_length_from_vertex[v] = ((covered[v]) ? 0 : (in_T[v]) ? 1 : 0);
-            next_max_length_from_vertex[v] = v;
-        }
-
-        for (std::vector<ListDigraph::Node>::reverse_iterator rit = top_order.rbegin(); rit != top_order.rend(); ++rit) {
-            ListDigraph::Node u = *rit;
-            int64_t max = -1;
-            for (ListDigraph::OutArcIt e(g, u); e != INVALID; ++e) {
-                ListDigraph::Node v = g.target(e);
-                int64_t max_v = max_length_from_vertex[v];
-                if (max_v > max) {
-                    max = max_v;
-                    next_max_length_from_vertex[u] = v;
-                    next_max_length_from_edges[u] = e;
+        path_cover_edges.push_back(path_edges);
+
+        // Update the DP of the ancestors of the newly covered vertices
+        while (!pending.empty()) {
+            ListDigraph::Node u = top_order[pending.top()];
+            pending.pop();
+            is_pending[u] = false;
+            if (!update(u)) continue;
+
+            if (in_S[u]) {
+                sources.push({max_length_from_vertex[u], position[u]});
+            }
+            for (ListDigraph::InArcIt e(g, u); e != INVALID; ++e) {
+                ListDigraph::Node w = g.source(e);
+                if (!is_pending[w]) {
+                    is_pending[w] = true;
+                    pending.push(position[w]);
                 }
             }
-
-            max_length_from_vertex[u] = ((covered[u] ? 0 : 1) + max > max_length_from_vertex[u]) ? (covered[u] ? 0 : 1) + max : max_length_from_vertex[u];
-            if (in_T[u] && ((covered[u] ? 0 : 1) == max_length_from_vertex[u])) {
-                next_max_length_from_vertex[u] = u;
-                next_max_length_from_edges[u] = null_edge;
-            }
-            if (max_length_from_vertex[u] > max_length && in_S[u]) {
-                max_length = max_length_from_vertex[u];
-                max_length_source = u;
-            }
         }
+    }
+}
 
-        std::vector<ListDigraph::Arc> path;
-        ListDigraph::Node v = max_length_source;
-        ListDigraph::Arc e = null_edge;
-        while (true) {
-            if (!covered[v]) {
-                covered[v] = true;
-                ++covered_vertices;
-            }
-            if (g.valid(next_max_length_from_edges[v]))
-                path.push_back(next_max_length_from_edges[v]);
-            if (v == next_max_length_from_vertex[v]) break;
-            v = next_max_length_from_vertex[v];
-            e = next_max_length_from_edges[v];
-        }
 
-        path_cover.push_back(path);
-    }
 
+std::vector<std::vector<ListDigraph::Node>> greedy_approximation_MPC(ListDigraph& g) {
+    std::vector<std::vector<ListDigraph::Node>> path_cover;
+    std::vector<std::vector<ListDigraph::Arc>> path_cover_edges;
+    greedy_approximation(g, nullptr, nullptr, nullptr, path_cover, path_cover_edges);
     return path_cover;
 }
 
 
 
-std::vector<std::vector<ListDigraph::Node>> greedy_approximation_U_MPC(ListDigraph& g, std::vector<ListDigraph::Node>& U) {
-
+std::vector<std::vector<ListDigraph::Arc>> greedy_approximation_MPC_edges(ListDigraph& g) {
     std::vector<std::vector<ListDigraph::Node>> path_cover;
-    std::vector<ListDigraph::Node> top_order = topological_sort(g);
+    std::vector<std::vector<ListDigraph::Arc>> path_cover_edges;
+    greedy_approximation(g, nullptr, nullptr, nullptr, path_cover, path_cover_edges);
+    return path_cover_edges;
+}
 
-    int64_t u = U.size();
-    int64_t covered_vertices = 0;
 
-    // Set as false only the vertices in U
-    ListDigraph::NodeMap<bool> covered(g, true);
-    for (ListDigraph::Node v : U) {
-        covered[v] = false;
-    }
 
-    while (covered_vertices < u) {
-        int64_t max_length = 0;
-        ListDigraph::Node max_length_source = top_order[0];
+std::vector<std::vector<ListDigraph::Node>> greedy_approximation_MPC(ListDigraph& g, std::vector<ListDigraph::Node>& S, std::vector<ListDigraph::Node>& T) {
+    std::vector<std::vector<ListDigraph::Node>> path_cover;
+    std::vector<std::vector<ListDigraph::Arc>> path_cover_edges;
+    greedy_approximation(g, &S, &T, nullptr, path_cover, path_cover_edges);
+    return path_cover;
+}
 
-        ListDigraph::NodeMap<int64_t> max_length_from_vertex(g);
-        ListDigraph::NodeMap<ListDigraph::Node> next_max_length_from_vertex(g);
-        for (ListDigraph::Node v : top_order) {
-            max_length_from_vertex[v] = ((covered[v]) ? 0 : 1);
-            next_max_length_from_vertex[v] = v;
-        }
 
-        for (std::vector<ListDigraph::Node>::reverse_iterator rit = top_order.rbegin(); rit != top_order.rend(); ++rit) {
-            ListDigraph::Node u = *rit;
-            int64_t max = 0;
-            for (ListDigraph::OutArcIt e(g, u); e != INVALID; ++e) {
-                ListDigraph::Node v = g.target(e);
-                int64_t max_v = max_length_from_vertex[v];
-                if (max_v > max) {
-                    max = max_v;
-                    next_max_length_from_vertex[u] = v;
-                }
-            }
 
-            max_length_from_vertex[u] = max + max_length_from_vertex[u];
-            if (max_length_from_vertex[u] > max_length) {
-                max_length = max_length_from_vertex[u];
-                max_length_source = u;
-            }
-        }
+std::vector<std::vector<ListDigraph::Arc>> greedy_approximation_MPC_edges(ListDigraph& g, std::vector<ListDigraph::Node>& S, std::vector<ListDigraph::Node>& T) {
+    std::vector<std::vector<ListDigraph::Node>> path_cover;
+    std::vector<std::vector<ListDigraph::Arc>> path_cover_edges;
+    greedy_approximation(g, &S, &T, nullptr, path_cover, path_cover_edges);
+    return path_cover_edges;
+}
 
-        std::vector<ListDigraph::Node> path;
-        ListDigraph::Node v = max_length_source;
-        while (true) {
-            if (!covered[v]) {
-                covered[v] = true;
-                ++covered_vertices;
-            }
-            path.push_back(v);
-            if (v == next_max_length_from_vertex[v]) break;
-            v = next_max_length_from_vertex[v];
-        }
 
-        path_cover.push_back(path);
-    }
 
+std::vector<std::vector<ListDigraph::Node>> greedy_approximation_U_MPC(ListDigraph& g, std::vector<ListDigraph::Node>& U) {
+    std::vector<std::vector<ListDigraph::Node>> path_cover;
+    std::vector<std::vector<ListDigraph::Arc>> path_cover_edges;
+    greedy_approximation(g, nullptr, nullptr, &U, path_cover, path_cover_edges);
     return path_cover;
 }
 
 
 
 std::vector<std::vector<ListDigraph::Arc>> greedy_approximation_U_MPC_edges(ListDigraph& g, std::vector<ListDigraph::Node>& U) {
-
-    ListDigraph::Arc null_edge(INVALID);
-    std::vector<std::vector<ListDigraph::Arc>> path_cover;
-    std::vector<ListDigraph::Node> top_order = topological_sort(g);
-
-    int64_t u = U.size();
-    int64_t covered_vertices = 0;
-    // Set as false only the vertices in U
-    ListDigraph::NodeMap<bool> covered(g, true);
-    for (ListDigraph::Node v : U) {
-        covered[v] = false;
-    }
-
-    while (covered_vertices < u) {
-        int64_t max_length = 0;
-        ListDigraph::Node max_length_source = top_order[0];
-
-        ListDigraph::NodeMap<int64_t> max_length_from_vertex(g);
-        ListDigraph::NodeMap<ListDigraph::Node> next_max_length_from_vertex(g);
-        ListDigraph::NodeMap<ListDigraph::Arc> next_max_length_from_edges(g, null_edge);
-
-        for (ListDigraph::Node v : top_order) {
-            max_length_from_vertex[v] = ((covered[v]) ? 0 : 1);
-            next_max_length_from_vertex[v] = v;
-        }
-
-        for (std::vector<ListDigraph::Node>::reverse_iterator rit = top_order.rbegin(); rit != top_order.rend(); ++rit) {
-            ListDigraph::Node u = *rit;
-            int64_t max = 0;
-            for (ListDigraph::OutArcIt e(g, u); e != INVALID; ++e) {
-                ListDigraph::Node v = g.target(e);
-                int64_t max_v = max_length_from_vertex[v];
-                if (max_v > max) {
-                    max = max_v;
-                    next_max_length_from_vertex[u] = v;
-                    next_max_length_from_edges[u] = e;
-                }
-            }
-
-            max_length_from_vertex[u] = max + max_length_from_vertex[u];
-            if (max_length_from_vertex[u] > max_length) {
-                max_length = max_length_from_vertex[u];
-                max_length_source = u;
-            }
-        }
-
-        std::vector<ListDigraph::Arc> path;
-        ListDigraph::Node v = max_length_source;
-        ListDigraph::Arc e = null_edge;
-        while (true) {
-            if (!covered[v]) {
-                covered[v] = true;
-                ++covered_vertices;
-            }
-            if (g.valid(next_max_length_from_edges[v]))
-                path.push_back(next_max_length_from_edges[v]);
-            if (v == next_max_length_from_vertex[v]) break;
-            v = next_max_length_from_vertex[v];
-            e = next_max_length_from_edges[v];
-        }
-
-        path_cover.push_back(path);
-    }
-
-    return path_cover;
+    std::vector<std::vector<ListDigraph::Node>> path_cover;
+    std::vector<std::vector<ListDigraph::Arc>> path_cover_edges;
+    greedy_approximation(g, nullptr, nullptr, &U, path_cover, path_cover_edges);
+    return path_cover_edges;
 }
 
 
 
 std::vector<std::vector<ListDigraph::Node>> greedy_approximation_U_MPC(ListDigraph& g, std::vector<ListDigraph::Node>& S, std::vector<ListDigraph::Node>& T, std::vector<ListDigraph::Node>& U) {
-
     std::vector<std::vector<ListDigraph::Node>> path_cover;
-    std::vector<ListDigraph::Node> top_order = topological_sort(g);
-
-    int64_t u = U.size();
-    int64_t covered_vertices = 0;
-    // Set as false only the vertices in U
-    ListDigraph::NodeMap<bool> covered(g, true);
-    for (ListDigraph::Node v : U) {
-        covered[v] = false;
-    }
-
-    ListDigraph::NodeMap<bool> in_T(g, false);
-    ListDigraph::NodeMap<bool> in_S(g, false);
-    for (ListDigraph::Node v : T) {
-        in_T[v] = true;
-    }
-    for (ListDigraph::Node v : S) {
-        in_S[v] = true;
-    }
-
-
-    while (covered_vertices < u) {
-        int64_t max_length = 0;
-        ListDigraph::Node max_length_source = top_order[0];
-
-        ListDigraph::NodeMap<int64_t> max_length_from_vertex(g);
-        ListDigraph::NodeMap<ListDigraph::Node> next_max_length_from_vertex(g);
-        for (ListDigraph::Node v : top_order) {
-            max_length_from_vertex[v] = ((covered[v]) ? 0 : (in_T[v]) ? 1 : 0);
-            next_max_length_from_vertex[v] = v;
-        }
-
-        for (std::vector<ListDigraph::Node>::reverse_iterator rit = top_order.rbegin(); rit != top_order.rend(); ++rit) {
-            ListDigraph::Node u = *rit;
-            int64_t max = -1;
-            for (ListDigraph::OutArcIt e(g, u); e != INVALID; ++e) {
-                ListDigraph::Node v = g.target(e);
-                int64_t max_v = max_length_from_vertex[v];
-                if (max_v > max) {
-                    max = max_v;
-                    next_max_length_from_vertex[u] = v;
-                }
-            }
-
-            max_length_from_vertex[u] = ((covered[u] ? 0 : 1) + max > max_length_from_vertex[u]) ? (covered[u] ? 0 : 1) + max : max_length_from_vertex[u];
-            if (in_T[u] && ((covered[u] ? 0 : 1) == max_length_from_vertex[u])) {
-                next_max_length_from_vertex[u] = u;
-            }
-            if (max_length_from_vertex[u] > max_length && in_S[u]) {
-                max_length = max_length_from_vertex[u];
-                max_length_source = u;
-            }
-        }
-
-        std::vector<ListDigraph::Node> path;
-        ListDigraph::Node v = max_length_source;
-        while (true) {
-            if (!covered[v]) {
-                covered[v] = true;
-                ++covered_vertices;
-            }
-            path.push_back(v);
-            if (v == next_max_length_from_vertex[v]) break;
-            v = next_max_length_from_vertex[v];
-        }
-
-        path_cover.push_back(path);
-    }
-
+    std::vector<std::vector<ListDigraph::Arc>> path_cover_edges;
+    greedy_approximation(g, &S, &T, &U, path_cover, path_cover_edges);
     return path_cover;
 }
 
 
 
 std::vector<std::vector<ListDigraph::Arc>> greedy_approximation_U_MPC_edges(ListDigraph& g, std::vector<ListDigraph::Node>& S, std::vector<ListDigraph::Node>& T, std::vector<ListDigraph::Node>& U) {
-
-    ListDigraph::Arc null_edge(INVALID);
-    std::vector<std::vector<ListDigraph::Arc>> path_cover;
-    std::vector<ListDigraph::Node> top_order = topological_sort(g);
-
-    int64_t u = U.size();
-    int64_t covered_vertices = 0;
-    // Set as false only the vertices in U
-    ListDigraph::NodeMap<bool> covered(g, true);
-    for (ListDigraph::Node v : U) {
-        covered[v] = false;
-    }
-
-    ListDigraph::NodeMap<bool> in_T(g, false);
-    ListDigraph::NodeMap<bool> in_S(g, false);
-    for (ListDigraph::Node v : T) {
-        in_T[v] = true;
-    }
-    for (ListDigraph::Node v : S) {
-        in_S[v] = true;
-    }
-
-
-    while (covered_vertices < u) {
-        int64_t max_length = 0;
-        ListDigraph::Node max_length_source = top_order[0];
-
-        ListDigraph::NodeMap<int64_t> max_length_from_vertex(g);
-        ListDigraph::NodeMap<ListDigraph::Node> next_max_length_from_vertex(g);
-        ListDigraph::NodeMap<ListDigraph::Arc> next_max_length_from_edges(g, null_edge);
-
-        for (ListDigraph::Node v : top_order) {
-            max_length_from_vertex[v] = ((covered[v]) ? 0 : (in_T[v]) ? 1 : 0);
-            next_max_length_from_vertex[v] = v;
-        }
-
-        for (std::vector<ListDigraph::Node>::reverse_iterator rit = top_order.rbegin(); rit != top_order.rend(); ++rit) {
-            ListDigraph::Node u = *rit;
-            int64_t max = -1;
-            for (ListDigraph::OutArcIt e(g, u); e != INVALID; ++e) {
-                ListDigraph::Node v = g.target(e);
-                int64_t max_v = max_length_from_vertex[v];
-                if (max_v > max) {
-                    max = max_v;
-                    next_max_length_from_vertex[u] = v;
-                    next_max_length_from_edges[u] = e;
-                }
-            }
-
-            max_length_from_vertex[u] = ((covered[u] ? 0 : 1) + max > max_length_from_vertex[u]) ? (covered[u] ? 0 : 1) + max : max_length_from_vertex[u];
-            if (in_T[u] && ((covered[u] ? 0 : 1) == max_length_from_vertex[u])) {
-                next_max_length_from_vertex[u] = u;
-                next_max_length_from_edges[u] = null_edge;
-            }
-            if (max_length_from_vertex[u] > max_length && in_S[u]) {
-                max_length = max_length_from_vertex[u];
-                max_length_source = u;
-            }
-        }
-
-        std::vector<ListDigraph::Arc> path;
-        ListDigraph::Node v = max_length_source;
-        ListDigraph::Arc e = null_edge;
-        while (true) {
-            if (!covered[v]) {
-                covered[v] = true;
-                ++covered_vertices;
-            }
-            if (g.valid(next_max_length_from_edges[v]))
-                path.push_back(next_max_length_from_edges[v]);
-            if (v == next_max_length_from_vertex[v]) break;
-            v = next_max_length_from_vertex[v];
-            e = next_max_length_from_edges[v];
-        }
-
-        path_cover.push_back(path);
-    }
-
-    return path_cover;
-}
\ No newline at end of file
+    std::vector<std::vector<ListDigraph::Node>> path_cover;
+    std::vector<std::vector<ListDigraph::Arc>> path_cover_edges;
+    greedy_approximation(g, &S, &T, &U, path_cover, path_cover_edges);
+    return path_cover_edges;
+}
@@ -0,0 +1,397 @@
+#include <algorithms/max_flow.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+
+
+/*
+ * Finds a shortest path in the residual network from root to a
+ * node v with is_end(v), along residual arcs, or against them if
+ * backwards. It returns the end of the path (or INVALID_ARC if
+ * there is none), pred_arc stores the arc of the path at every node
+ */
+template <typename IsEnd>
+static int32_t residual_bfs(const FlowNetwork& red, const std::vector<int64_t>& capacities, const std::vector<int64_t>& flow, int32_t root, bool backwards, IsEnd is_end, std::vector<int32_t>& pred_arc, std::vector<int32_t>& queue) {
+    std::fill(pred_arc.begin(), pred_arc.end(), FlowNetwork::INVALID_ARC);
+    int32_t head = 0, tail = 0;
+    queue[tail++] = root;
+    while (head < tail) {
+        int32_t u = queue[head++];
+        for (FlowNetwork::OutArcIt out(red, u); out != FlowNetwork::INVALID_ARC; ++out) {
+            // Backwards, the arc entering u is the twin of out
+            int32_t a = backwards ? FlowNetwork::twin(out) : (int32_t) out;
+            int32_t v = red.target(out);
+            if (v != root && pred_arc[v] == FlowNetwork::INVALID_ARC && capacities[a] - flow[a] > 0) {
+                pred_arc[v] = a;
+                if (is_end(v)) {
+                    return v;
+                }
+                queue[tail++] = v;
+            }
+        }
+    }
+    return FlowNetwork::INVALID_ARC;
+}
+
+
+
+// Pushes amount units of flow along the path from from to to stored in pred_arc
+static void push(const FlowNetwork& red, std::vector<int64_t>& flow, int32_t from, int32_t to, const std::vector<int32_t>& pred_arc, bool backwards, int64_t amount) {
+    for (int32_t v = to; v != from; ) {
+        int32_t a = pred_arc[v];
+        flow[a] += amount;
+        flow[FlowNetwork::twin(a)] -= amount;
+        v = backwards ? red.target(a) : red.source(a);
+    }
+}
+
+
+
+// Bottleneck of the path from from to to stored in pred_arc
+static int64_t bottleneck(const FlowNetwork& red, const std::vector<int64_t>& capacities, const std::vector<int64_t>& flow, int32_t from, int32_t to, const std::vector<int32_t>& pred_arc, bool backwards) {
+    int64_t amount = capacities[pred_arc[to]] - flow[pred_arc[to]];
+    for (int32_t v = to; v != from; ) {
+        int32_t a = pred_arc[v];
+        amount = std::min(amount, capacities[a] - flow[a]);
+        v = backwards ? red.target(a) : red.source(a);
+    }
+    return amount;
+}
+
+
+
+// Edmonds-Karp: augments flow along shortest s-t paths until it is maximum
+// or its value increased by at least limit, it returns the increase of its value
+static int64_t augment_edmonds_karp(const FlowNetwork& red, const std::vector<int64_t>& capacities, int32_t s, int32_t t, std::vector<int64_t>& flow, int64_t limit) {
+
+    int64_t flow_value = 0;
+
+    std::vector<int32_t> pred_arc(red.nodeCount());
+    std::vector<int32_t> queue(red.nodeCount());
+    auto is_t = [t](int32_t v) { return v == t; };
+
+    // Augment the flow by the bottleneck of a shortest path in the residual network
+    while (flow_value < limit && residual_bfs(red, capacities, flow, s, false, is_t, pred_arc, queue) != FlowNetwork::INVALID_ARC) {
+        int64_t amount = bottleneck(red, capacities, flow, s, t, pred_arc, false);
+        push(red, flow, s, t, pred_arc, false, amount);
+        flow_value += amount;
+    }
+
+    return flow_value;
+}
+
+
+
+// Dinic: augments flow with blocking flows of the level graph until it is maximum
+// or its value increased by at least limit, it returns the increase of its value
+static int64_t augment_dinic(const FlowNetwork& red, const std::vector<int64_t>& capacities, int32_t s, int32_t t, std::vector<int64_t>& flow, int64_t limit) {
+
+    int64_t flow_value = 0;
+
+    std::vector<int32_t> level(red.nodeCount());
+    std::vector<int32_t> queue(red.nodeCount());
+    std::vector<FlowNetwork::OutArcIt> current_arc;
+    std::vector<int32_t> path;
+
+    while (flow_value < limit) {
+        // Compute the level graph with a BFS in the residual network
+        std::fill(level.begin(), level.end(), -1);
+        int32_t head = 0, tail = 0;
+        queue[tail++] = s;
+        level[s] = 0;
+        while (head < tail) {
+            int32_t u = queue[head++];
+            for (FlowNetwork::OutArcIt a(red, u); a != FlowNetwork::INVALID_ARC; ++a) {
+                int32_t v = red.target(a);
+                if (level[v] == -1 && capacities[a] - flow[a] > 0) {
+                    level[v] = level[u] + 1;
+                    queue[tail++] = v;
+                }
+            }
+        }
+
+        if (level[t] == -1) break;
+
+        // Compute a blocking flow with an (iterative) DFS along the current arc of every node,
+        // for unit capacities every arc is saturated by its first path and it is never visited again
+        current_arc.clear();
+        for (int32_t v = 0; v < red.nodeCount(); ++v) {
+            current_arc.emplace_back(red, v);
+        }
+        path.clear();
+        int32_t u = s;
+        while (flow_value < limit) {
+            if (u == t) {
+                int64_t amount = limit - flow_value;
+                for (int32_t a : path) {
+                    amount = std::min(amount, capacities[a] - flow[a]);
+                }
+                for (int32_t a : path) {
+                    flow[a] += amount;
+                    flow[FlowNetwork::twin(a)] -= amount;
+                }
+                flow_value += amount;
+
+                // Retreat to the source of the first saturated arc
+                size_t k = 0;
+                while (k < path.size() && capacities[path[k]] - flow[path[k]] > 0) {
+                    ++k;
+                }
+                if (k == path.size()) break; // The limit was reached
+                u = red.source(path[k]);
+                path.resize(k);
+                continue;
+            }
+
+            FlowNetwork::OutArcIt& a = current_arc[u];
+            while (a != FlowNetwork::INVALID_ARC && !(capacities[a] - flow[a] > 0 && level[red.target(a)] == level[u] + 1)) {
+                ++a;
+            }
+
+            if (a != FlowNetwork::INVALID_ARC) {
+                path.push_back(a);
+                u = red.target(a);
+            } else {
+                // Dead end, no path goes through u in this phase
+                level[u] = -1;
+                if (u == s) break;
+                u = red.source(path.back());
+                path.pop_back();
+                ++current_arc[u];
+            }
+        }
+    }
+
+    return flow_value;
+}
+
+
+
+// Push-relabel (FIFO): computes a maximum flow starting from flow, it returns the increase of its value
+static int64_t augment_push_relabel(const FlowNetwork& red, const std::vector<int64_t>& capacities, int32_t s, int32_t t, std::vector<int64_t>& flow) {
+
+    int32_t n = red.nodeCount();
+    std::vector<int64_t> excess(n, 0);
+    std::vector<int32_t> height(n, 2 * n);
+    std::vector<bool> active(n, false);
+    std::vector<int32_t> queue;
+
+    int64_t initial_value = 0;
+    for (FlowNetwork::InArcIt a(red, t); a != FlowNetwork::INVALID_ARC; ++a) {
+        initial_value += flow[a];
+    }
+
+    auto push = [&](int32_t a, int64_t amount) {
+        int32_t v = red.target(a);
+        flow[a] += amount;
+        flow[FlowNetwork::twin(a)] -= amount;
+        excess[red.source(a)] -= amount;
+        excess[v] += amount;
+        if (!active[v] && v != s && v != t) {
+            active[v] = true;
+            queue.push_back(v);
+        }
+    };
+
+    // Saturate the arcs leaving s
+    for (FlowNetwork::OutArcIt a(red, s); a != FlowNetwork::INVALID_ARC; ++a) {
+        if (capacities[a] - flow[a] > 0) {
+            push(a, capacities[a] - flow[a]);
+        }
+    }
+
+    // Initial heights: the distance to t in the residual network, or n plus the
+    // distance to s if t is not reachable (the excess of these nodes goes back to s)
+    std::vector<int32_t> bfs_queue;
+    for (int32_t root : {t, s}) {
+        int32_t base_height = (root == t) ? 0 : n;
+        height[root] = base_height;
+        bfs_queue.assign(1, root);
+        for (size_t head = 0; head < bfs_queue.size(); ++head) {
+            int32_t v = bfs_queue[head];
+            for (FlowNetwork::InArcIt a(red, v); a != FlowNetwork::INVALID_ARC; ++a) {
+                int32_t u = red.source(a);
+                if (height[u] == 2 * n && capacities[a] - flow[a] > 0) {
+                    height[u] = height[v] + 1;
+                    bfs_queue.push_back(u);
+                }
+            }
+        }
+    }
+
+    // Number of nodes at every height below n, for the gap heuristic
+    std::vector<int32_t> count(n, 0);
+    for (int32_t v = 0; v < n; ++v) {
+        if (height[v] < n) {
+            ++count[height[v]];
+        }
+    }
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int32_t u = queue[head];
+        active[u] = false;
+
+        // Discharge u
+        while (excess[u] > 0) {
+            int32_t min_height = 2 * n;
+            for (FlowNetwork::OutArcIt a(red, u); a != FlowNetwork::INVALID_ARC && excess[u] > 0; ++a) {
+                int64_t residual = capacities[a] - flow[a];
+                if (residual <= 0) continue;
+                int32_t v = red.target(a);
+                if (height[u] == height[v] + 1) {
+                    push(a, std::min(excess[u], residual));
+                } else {
+                    min_height = std::min(min_height, height[v]);
+                }
+            }
+            if (excess[u] > 0) {
+                int32_t old_height = height[u];
+                int32_t new_height = min_height + 1;
+                if (old_height < n) {
+                    --count[old_height];
+                    if (count[old_height] == 0) {
+                        // Gap: the nodes above old_height can no longer reach t
+                        for (int32_t v = 0; v < n; ++v) {
+                            if (old_height < height[v] && height[v] < n && v != s) {
+                                --count[height[v]];
+                                height[v] = n + 1;
+                            }
+                        }
+                        new_height = std::max(new_height, n + 1);
+                    }
+                }
+                height[u] = new_height;
+                if (height[u] < n) {
+                    ++count[height[u]];
+                }
+            }
+        }
+    }
+
+    int64_t flow_value = 0;
+    for (FlowNetwork::InArcIt a(red, t); a != FlowNetwork::INVALID_ARC; ++a) {
+        flow_value += flow[a];
+    }
+    return flow_value - initial_value;
+}
+
+
+
+// Augments flow until it is maximum (or its value increased by at least limit, if the algorithm can stop there)
+static int64_t augment(MaxFlowAlgorithm algorithm, const FlowNetwork& red, const std::vector<int64_t>& capacities, int32_t s, int32_t t, std::vector<int64_t>& flow, int64_t limit) {
+    switch (algorithm) {
+        case MaxFlowAlgorithm::DINIC:
+            return augment_dinic(red, capacities, s, t, flow, limit);
+        case MaxFlowAlgorithm::PUSH_RELABEL:
+            return augment_push_relabel(red, capacities, s, t, flow);
+        default:
+            return augment_edmonds_karp(red, capacities, s, t, flow, limit);
+    }
+}
+
+
+
+int64_t max_flow(const FlowNetwork& red, const std::vector<int64_t>& capacities, int32_t s, int32_t t, std::vector<int64_t>& flow, MaxFlowAlgorithm algorithm) {
+    flow.assign(red.arcCount(), 0);
+    return augment(algorithm, red, capacities, s, t, flow, std::numeric_limits<int64_t>::max());
+}
+
+
+
+bool parse_max_flow_algorithm(const std::string& name, MaxFlowAlgorithm& algorithm) {
+    if (name == "edmonds_karp") {
+        algorithm = MaxFlowAlgorithm::EDMONDS_KARP;
+    } else if (name == "dinic") {
+        algorithm = MaxFlowAlgorithm::DINIC;
+    } else if (name == "push_relabel") {
+        algorithm = MaxFlowAlgorithm::PUSH_RELABEL;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+
+
+void reset_incremental_flow(IncrementalFlow& state, const FlowNetwork& red) {
+    state.flow.assign(red.arcCount(), 0);
+    state.excess.assign(red.nodeCount(), 0);
+    state.unbalanced.clear();
+}
+
+
+
+// Moves amount units of flow out of a, leaving the imbalance at its endpoints
+static void cut(IncrementalFlow& state, const FlowNetwork& red, int32_t a, int64_t amount) {
+    state.flow[a] -= amount;
+    state.flow[FlowNetwork::twin(a)] += amount;
+    state.excess[red.source(a)] += amount;
+    state.excess[red.target(a)] -= amount;
+    state.unbalanced.push_back(red.source(a));
+    state.unbalanced.push_back(red.target(a));
+}
+
+
+
+void cut_flow(IncrementalFlow& state, const FlowNetwork& red, int32_t a) {
+    if (state.flow[a] != 0) {
+        cut(state, red, a, state.flow[a]);
+    }
+}
+
+
+
+void fit_flow(IncrementalFlow& state, const FlowNetwork& red, const std::vector<int64_t>& capacities, int32_t a) {
+    for (int32_t b : {a, FlowNetwork::twin(a)}) {
+        if (state.flow[b] > capacities[b]) {
+            cut(state, red, b, state.flow[b] - capacities[b]);
+        }
+    }
+}
+
+
+
+int64_t incremental_max_flow(IncrementalFlow& state, const FlowNetwork& red, const std::vector<int64_t>& capacities, int32_t s, int32_t t, int64_t limit, MaxFlowAlgorithm algorithm) {
+
+    std::vector<int64_t>& flow = state.flow;
+    std::vector<int64_t>& excess = state.excess;
+
+    std::vector<int32_t> pred_arc(red.nodeCount());
+    std::vector<int32_t> queue(red.nodeCount());
+
+    // Repair the conservation of flow: the excess of a node is sent to s, t or a node
+    // with deficit, and the deficit of a node is taken from s, t or a node with excess.
+    // Such a path always exists, otherwise the nodes reachable from (reaching) the node
+    // would have a positive (negative) total excess with no residual arc leaving (entering) them
+    auto is_terminal = [s, t](int32_t v) { return v == s || v == t; };
+    for (int32_t u : state.unbalanced) {
+        if (is_terminal(u)) continue;
+        while (excess[u] != 0) {
+            bool backwards = excess[u] < 0;
+            auto is_end = [&](int32_t v) { return is_terminal(v) || (backwards ? excess[v] > 0 : excess[v] < 0); };
+            int32_t v = residual_bfs(red, capacities, flow, u, backwards, is_end, pred_arc, queue);
+
+            int64_t amount = std::min(std::abs(excess[u]), bottleneck(red, capacities, flow, u, v, pred_arc, backwards));
+            if (!is_terminal(v)) {
+                amount = std::min(amount, std::abs(excess[v]));
+            }
+            push(red, flow, u, v, pred_arc, backwards, amount);
+            excess[u] += backwards ? amount : -amount;
+            excess[v] += backwards ? -amount : amount;
+        }
+    }
+    state.unbalanced.clear();
+
+    // The value of the flow is the flow entering t
+    int64_t flow_value = 0;
+    for (FlowNetwork::InArcIt a(red, t); a != FlowNetwork::INVALID_ARC; ++a) {
+        flow_value += flow[a];
+    }
+
+    if (flow_value < limit) {
+        flow_value += augment(algorithm, red, capacities, s, t, flow, limit - flow_value);
+    }
+    return flow_value;
+}
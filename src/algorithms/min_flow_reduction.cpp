@@ -0,0 +1,544 @@
+#include <algorithms/min_flow_reduction.h>
+
+#include <algorithms/greedy_approx.h>
+#include <algorithms/max_flow.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+
+using namespace lemon;
+
+
+
+MinFlowReduction::MinFlowReduction(ListDigraph& g, MaxFlowAlgorithm algorithm, int32_t threads) : g(g), algorithm(algorithm), threads(threads), in_U(g, false), in_S(g, false), split_edges(g, FlowNetwork::INVALID_ARC), s(0), t(0), reverse_capacity(countNodes(g)), width(0) {}
+
+
+
+MinFlowReduction::MinFlowReduction(const MinFlowReduction& other) : g(other.g), algorithm(other.algorithm), threads(other.threads), in_U(other.g), in_S(other.g), split_edges(other.g),
+        red(other.red), s(other.s), t(other.t), reverse_capacity(other.reverse_capacity), original(other.original), original_edge(other.original_edge),
+        feasible_flow(other.feasible_flow), capacities(other.capacities), capacity_journal(other.capacity_journal), warm_flow(other.warm_flow),
+        width(other.width), path_cover(other.path_cover), path_cover_edges_red(other.path_cover_edges_red), paths_through(other.paths_through) {
+    for (ListDigraph::NodeIt v(g); v != INVALID; ++v) {
+        in_U[v] = other.in_U[v];
+        in_S[v] = other.in_S[v];
+        split_edges[v] = other.split_edges[v];
+    }
+}
+
+
+
+// Adds the edge u -> v with its arc maps, its twin is its reverse edge
+static int32_t add_edge(MinFlowReduction& reduction, int32_t u, int32_t v, int64_t flow) {
+    int32_t e = reduction.red.addArc(u, v);
+    int32_t arc_count = reduction.red.arcCount();
+
+    reduction.original_edge.resize(arc_count, INVALID);
+    reduction.feasible_flow.resize(arc_count, 0);
+    reduction.capacities.resize(arc_count, 0);
+    reduction.warm_flow.flow.resize(arc_count, 0);
+
+    reduction.feasible_flow[e] = flow;
+    reduction.capacities[e] = flow;
+    reduction.capacities[FlowNetwork::twin(e)] = reduction.reverse_capacity;
+    return e;
+}
+
+
+
+// Bfs from root using only the edges of the reduction, it stores the edge reaching every node
+static void bfs_from(const FlowNetwork& red, int32_t root, std::vector<int32_t>& pred_arc) {
+    pred_arc.assign(red.nodeCount(), FlowNetwork::INVALID_ARC);
+    std::vector<bool> reached(red.nodeCount(), false);
+    std::vector<int32_t> queue;
+    queue.push_back(root);
+    reached[root] = true;
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int32_t u = queue[head];
+        for (FlowNetwork::OutArcIt a(red, u); a != FlowNetwork::INVALID_ARC; ++a) {
+            int32_t v = red.target(a);
+            if (FlowNetwork::isForward(a) && !reached[v]) {
+                reached[v] = true;
+                pred_arc[v] = a;
+                queue.push_back(v);
+            }
+        }
+    }
+}
+
+
+
+// Bfs to root following the edges of the reduction backwards (over in-arcs),
+// it stores the edge leaving every node towards root
+static void bfs_to(const FlowNetwork& red, int32_t root, std::vector<int32_t>& succ_arc) {
+    succ_arc.assign(red.nodeCount(), FlowNetwork::INVALID_ARC);
+    std::vector<bool> reached(red.nodeCount(), false);
+    std::vector<int32_t> queue;
+    queue.push_back(root);
+    reached[root] = true;
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int32_t v = queue[head];
+        for (FlowNetwork::InArcIt a(red, v); a != FlowNetwork::INVALID_ARC; ++a) {
+            int32_t u = red.source(a);
+            if (FlowNetwork::isForward(a) && !reached[u]) {
+                reached[u] = true;
+                succ_arc[u] = a;
+                queue.push_back(u);
+            }
+        }
+    }
+}
+
+
+
+// Adds delta to the capacity of a, recording it in journal
+static void modify_capacity(std::vector<int64_t>& capacities, std::vector<std::pair<int32_t, int64_t>>& journal, int32_t a, int64_t delta) {
+    capacities[a] += delta;
+    journal.push_back({a, delta});
+}
+
+
+
+// Keeps every edge u -> v of g used by the greedy paths, and for every path p, the edge
+// from the in-neighbor of v that appears last in p (the other in-neighbors in p reach it along p)
+static void sparsify_edges(ListDigraph& g, std::vector<std::vector<ListDigraph::Arc>>& paths, ListDigraph::ArcMap<int64_t>& mu, ListDigraph::ArcMap<bool>& keep) {
+
+    // A path containing every vertex and its last position in that path
+    ListDigraph::NodeMap<int32_t> chain(g, -1);
+    ListDigraph::NodeMap<int32_t> position(g, -1);
+    for (int32_t i = 0; i < (int32_t) paths.size(); ++i) {
+        for (int32_t j = 0; j < (int32_t) paths[i].size(); ++j) {
+            for (ListDigraph::Node v : {g.source(paths[i][j]), g.target(paths[i][j])}) {
+                if (chain[v] == -1 || chain[v] == i) {
+                    chain[v] = i;
+                    position[v] = (v == g.source(paths[i][j])) ? j : j+1;
+                }
+            }
+        }
+    }
+
+    std::vector<ListDigraph::Arc> last_in(paths.size(), INVALID);
+    std::vector<int32_t> touched;
+    for (ListDigraph::NodeIt v(g); v != INVALID; ++v) {
+        for (ListDigraph::InArcIt e(g, v); e != INVALID; ++e) {
+            ListDigraph::Node u = g.source(e);
+            int32_t c = chain[u];
+            if (mu[e] > 0 || c == -1) { // Edges with flow and edges from vertices in no path are kept
+                keep[e] = true;
+                continue;
+            }
+            if (last_in[c] == INVALID) {
+                touched.push_back(c);
+                last_in[c] = e;
+            } else if (position[g.source(last_in[c])] < position[u]) {
+                last_in[c] = e;
+            }
+        }
+        for (int32_t c : touched) {
+            keep[last_in[c]] = true;
+            last_in[c] = INVALID;
+        }
+        touched.clear();
+    }
+}
+
+
+
+static void build_reduction(MinFlowReduction& reduction, std::vector<ListDigraph::Node>& S, std::vector<ListDigraph::Node>& T, std::vector<ListDigraph::Node>& U, bool sparse) {
+
+    ListDigraph& g = reduction.g;
+    ListDigraph::NodeMap<bool>& in_U = reduction.in_U;
+    ListDigraph::NodeMap<int32_t>& split_edges = reduction.split_edges;
+
+    // Compute in_U
+    for (ListDigraph::Node v : U) {
+        in_U[v] = true;
+    }
+    for (ListDigraph::Node v : S) {
+        reduction.in_S[v] = true;
+    }
+
+    // Build the Min-Flow network reduction
+    std::vector<std::vector<ListDigraph::Arc>> paths = greedy_approximation_U_MPC_edges(g, S, T, U);
+
+    // Compute mu values according to the current path cover
+    ListDigraph::ArcMap<int64_t> mu(g, 0); // Number of paths using this edge
+    ListDigraph::NodeMap<int64_t> mu_v(g, 0); // Number of paths using this vertex
+    ListDigraph::NodeMap<int64_t> starting_at(g, 0); // Number of paths starting at this vertex
+    ListDigraph::NodeMap<int64_t> ending_at(g, 0); // Number of paths ending at this vertex
+    for (auto& path: paths) {
+        for (int i = 0; i < path.size(); ++i) {
+            auto edge = path[i];
+            mu[edge]++;
+            mu_v[g.source(edge)]++;
+            if (i == path.size()-1) {
+                mu_v[g.target(edge)]++;
+                ending_at[g.target(edge)]++;
+            }
+            if (i == 0) {
+                starting_at[g.source(edge)]++;
+            }
+        }
+    }
+    // Put flow in the corresponding vertices covered by a path of length one (does not appear in the answer)
+    for (ListDigraph::NodeIt v(g); v != INVALID; ++v) {
+        if (mu_v[v] == 0 && in_U[v]) {
+            mu_v[v]++;
+            starting_at[v]++;
+            ending_at[v]++;
+        }
+    }
+
+    FlowNetwork& red = reduction.red;
+    reduction.s = red.addNode();
+    reduction.t = red.addNode();
+    reduction.original.assign(2, INVALID);
+
+    for (ListDigraph::NodeIt v(g); v != INVALID; ++v) {
+        int32_t v_in = red.addNode();
+        int32_t v_out = red.addNode();
+        reduction.original.push_back(v);
+        reduction.original.push_back(v);
+
+        int32_t split = add_edge(reduction, v_in, v_out, mu_v[v]);
+        split_edges[v] = split;
+        if (in_U[v]) {
+            reduction.capacities[split]--;
+        }
+    }
+    for (ListDigraph::Node v : S) {
+        add_edge(reduction, reduction.s, red.source(split_edges[v]), starting_at[v]);
+    }
+    for (ListDigraph::Node v : T) {
+        add_edge(reduction, red.target(split_edges[v]), reduction.t, ending_at[v]);
+    }
+
+    ListDigraph::ArcMap<bool> keep(g, !sparse);
+    if (sparse) {
+        sparsify_edges(g, paths, mu, keep);
+    }
+    for (ListDigraph::ArcIt e(g); e != INVALID; ++e) {
+        if (!keep[e]) continue;
+        ListDigraph::Node u = g.source(e);
+        ListDigraph::Node v = g.target(e);
+
+        int32_t red_e = add_edge(reduction, red.target(split_edges[u]), red.source(split_edges[v]), mu[e]);
+        reduction.original_edge[red_e] = e;
+    }
+
+    red.build();
+}
+
+
+
+void build_greedy_min_flow_reduction(MinFlowReduction& reduction, std::vector<ListDigraph::Node>& S, std::vector<ListDigraph::Node>& T, std::vector<ListDigraph::Node>& U) {
+    build_reduction(reduction, S, T, U, false);
+}
+
+
+
+void build_sparse_greedy_min_flow_reduction(MinFlowReduction& reduction, std::vector<ListDigraph::Node>& S, std::vector<ListDigraph::Node>& T, std::vector<ListDigraph::Node>& U) {
+    build_reduction(reduction, S, T, U, true);
+}
+
+
+
+void solve_min_flow_reduction(MinFlowReduction& reduction) {
+
+    FlowNetwork& red = reduction.red;
+    std::vector<int64_t>& capacities = reduction.capacities;
+    int32_t s = reduction.s;
+    int32_t t = reduction.t;
+
+    // Run Max-Flow algorithm
+    std::vector<int64_t> flowMap;
+    max_flow(red, capacities, s, t, flowMap, reduction.algorithm);
+
+    // The flow on an edge is computed as the previous flow minus the one discounted by that edge
+    // (the Max-flow on its twin, the reverse edge, is pushed in the Min-flow)
+    std::vector<int64_t> flow(red.arcCount(), 0);
+    for (int32_t e = 0; e < red.arcCount(); e += 2) {
+        flow[e] = reduction.feasible_flow[e] - flowMap[e];
+        capacities[e] = flow[e];
+    }
+    for (ListDigraph::NodeIt v(reduction.g); v != INVALID; ++v) {
+        if (reduction.in_U[v]) {
+            capacities[reduction.split_edges[v]]--;
+        }
+    }
+
+    // Extract the Minimum Path Cover solution from the flow, every path from s to t along
+    // edges with flow is a path of the cover. The edges with flow form a DAG, so following
+    // them from s always reaches t, and every node keeps its first out-edge that may still
+    // have flow: all the paths are extracted in a single pass over the edges
+    std::vector<FlowNetwork::OutArcIt> current_arc;
+    current_arc.reserve(red.nodeCount());
+    for (int32_t v = 0; v < red.nodeCount(); ++v) {
+        current_arc.emplace_back(red, v);
+    }
+
+    while (true) {
+        while (current_arc[s] != FlowNetwork::INVALID_ARC && flow[current_arc[s]] <= 0) {
+            ++current_arc[s];
+        }
+        if (current_arc[s] == FlowNetwork::INVALID_ARC) break;
+
+        std::vector<ListDigraph::Node> path;
+        std::vector<int32_t> path_edges_red;
+
+        int32_t v = s;
+        while (v != t) {
+            FlowNetwork::OutArcIt& a = current_arc[v];
+            while (flow[a] <= 0) {
+                ++a;
+            }
+            int32_t e = a;
+            int32_t w = red.target(e);
+            flow[e]--;
+
+            if (reduction.original[v] != reduction.original[w]) { // Not a split edge
+                path_edges_red.push_back(e);
+                if (w != t) {
+                    path.push_back(reduction.original[w]);
+                }
+            }
+            v = w;
+        }
+
+        reduction.path_cover.push_back(path);
+        reduction.path_cover_edges_red.push_back(path_edges_red);
+    }
+
+    // The safety tests start from the zero flow
+    reset_incremental_flow(reduction.warm_flow, red);
+
+    reduction.width = reduction.path_cover.size();
+
+    // Compute the paths that goes through every edge
+    // These are stored as a vector of pairs {i, j}
+    // where i is the position of the path in path_cover_edges,
+    // and j is the position of the edge in that path
+    reduction.paths_through.assign(red.arcCount(), {});
+    for (int i = 0; i < reduction.path_cover_edges_red.size(); ++i) {
+        std::vector<int32_t>& path_edges_red = reduction.path_cover_edges_red[i];
+        for (int j = 0; j < path_edges_red.size(); ++j) {
+            reduction.paths_through[path_edges_red[j]].push_back({i, j});
+        }
+    }
+}
+
+
+
+int32_t add_transitive_edge(MinFlowReduction& reduction, int32_t u, int32_t v) {
+    return add_edge(reduction, u, v, 0);
+}
+
+
+
+void remove_transitive_edges(MinFlowReduction& reduction, int32_t arc_count) {
+    FlowNetwork& red = reduction.red;
+    for (int32_t a = arc_count; a < red.arcCount(); a += 2) {
+        cut_flow(reduction.warm_flow, red, a);
+    }
+
+    red.popArcs(arc_count);
+    reduction.original_edge.resize(arc_count);
+    reduction.feasible_flow.resize(arc_count);
+    reduction.capacities.resize(arc_count);
+    reduction.warm_flow.flow.resize(arc_count);
+}
+
+
+
+bool is_safe_removal(MinFlowReduction& reduction, int32_t e, int64_t l) {
+
+    FlowNetwork& red = reduction.red;
+    std::vector<int64_t>& capacities = reduction.capacities;
+    ListDigraph::NodeMap<bool>& in_U = reduction.in_U;
+    ListDigraph::NodeMap<int32_t>& split_edges = reduction.split_edges;
+    int32_t s = reduction.s;
+    int32_t t = reduction.t;
+
+    int64_t mu_e = capacities[e];
+
+    // Compute reduction (remove e and its reverse edge)
+    cut_flow(reduction.warm_flow, red, e);
+    red.disableArc(e);
+
+    // Redistribute the flow (if possible)
+
+    std::vector<int32_t> bfs_from_s;
+    bfs_from(red, s, bfs_from_s);
+    std::vector<int32_t> bfs_to_t;
+    bfs_to(red, t, bfs_to_t);
+
+    // For every path through e find the corresponding redistribution of flow
+    bool infinite_width = bfs_from_s[t] == FlowNetwork::INVALID_ARC;
+
+    std::vector<std::pair<int32_t, int64_t>>& journal = reduction.capacity_journal;
+    journal.clear();
+
+    if (!infinite_width) {
+        for (auto pair : reduction.paths_through[e]) {
+            int64_t i = pair.first;
+            int64_t j = pair.second;
+            auto& path = reduction.path_cover[i];
+            auto& path_edges_red = reduction.path_cover_edges_red[i];
+
+            // First check whether s reaches the first vertex in U in path[j...path.size()-1]
+            int64_t index_first_reached_by_s = path.size();
+            for (int64_t k = j; k < path.size(); ++k) {
+                ListDigraph::Node current_vertex = path[k];
+                if (bfs_from_s[red.source(split_edges[current_vertex])] != FlowNetwork::INVALID_ARC) {
+                    index_first_reached_by_s = k;
+                    break;
+                } else if (in_U[current_vertex]) {
+                    infinite_width = true;
+                    break;
+                }
+            }
+
+            if (infinite_width) break;
+
+            int64_t index_last_reaching_t = -1;
+            for (int64_t k = j-1; k >= 0; --k) {
+                ListDigraph::Node current_vertex = path[k];
+                if (bfs_to_t[red.target(split_edges[current_vertex])] != FlowNetwork::INVALID_ARC) {
+                    index_last_reaching_t = k;
+                    break;
+                } else if (in_U[current_vertex]) {
+                    infinite_width = true;
+                    break;
+                }
+            }
+
+            if (infinite_width) break;
+
+            // Remove 1 unit of flow from path[j...index_first_reached_by_s-1]
+            for (int64_t k = j; k < index_first_reached_by_s; ++k) {
+                modify_capacity(capacities, journal, split_edges[path[k]], -1);
+                modify_capacity(capacities, journal, path_edges_red[k+1], -1);
+            }
+
+            // Push 1 unit of flow in the path from s to index_first_reached_by_s
+            int32_t first_reached_by_s = t;
+            if (index_first_reached_by_s != path.size()) {
+                first_reached_by_s = red.source(split_edges[path[index_first_reached_by_s]]);
+            }
+            int32_t temp_e;
+            int32_t temp_v = first_reached_by_s;
+            while ((temp_e = bfs_from_s[temp_v]) != FlowNetwork::INVALID_ARC) {
+                modify_capacity(capacities, journal, temp_e, 1);
+                temp_v = red.source(temp_e);
+            }
+
+            // Remove 1 unit of flow from path[index_last_reaching_t+1...j-1]
+            for (int64_t k = index_last_reaching_t; k < j-1; ++k) {
+                modify_capacity(capacities, journal, path_edges_red[k+1], -1);
+                modify_capacity(capacities, journal, split_edges[path[k+1]], -1);
+            }
+
+            // Push 1 unit of flow in the path from index_last_reaching_t to t
+            int32_t last_reaching_t = s;
+            if (index_last_reaching_t != -1) {
+                last_reaching_t = red.target(split_edges[path[index_last_reaching_t]]);
+            }
+            temp_v = last_reaching_t;
+            while ((temp_e = bfs_to_t[temp_v]) != FlowNetwork::INVALID_ARC) {
+                modify_capacity(capacities, journal, temp_e, 1);
+                temp_v = red.target(temp_e);
+            }
+        }
+    }
+
+    bool safe = infinite_width;
+    if (!infinite_width) {
+        // Compute new width, starting from the flow of the previous test
+        for (auto& change : journal) {
+            fit_flow(reduction.warm_flow, red, capacities, change.first);
+        }
+        // e is not safe as soon as the flow reaches width + mu_e - l, so the Max-Flow can stop there
+        int64_t limit = reduction.width + mu_e - l;
+        int64_t new_width = reduction.width + mu_e - incremental_max_flow(reduction.warm_flow, red, capacities, s, t, limit, reduction.algorithm);
+        safe = new_width > l;
+    }
+
+    // Here put the flow back
+    for (auto it = journal.rbegin(); it != journal.rend(); ++it) {
+        capacities[it->first] -= it->second;
+    }
+    for (auto& change : journal) {
+        fit_flow(reduction.warm_flow, red, capacities, change.first);
+    }
+    journal.clear();
+
+    // Add e
+    red.enableArc(e);
+
+    return safe;
+}
+
+
+
+void parallel_for_each(MinFlowReduction& reduction, size_t count, const std::function<void(MinFlowReduction&, size_t)>& task) {
+
+    int32_t threads = std::min<size_t>(std::max(reduction.threads, 1), count);
+    if (threads <= 1) {
+        for (size_t i = 0; i < count; ++i) {
+            task(reduction, i);
+        }
+        return;
+    }
+
+    // The tasks modify (and restore) the reduction, so every thread works on its own copy.
+    // The copies are made (and destroyed) here, since the maps of g are not thread safe
+    std::vector<MinFlowReduction> copies;
+    copies.reserve(threads - 1);
+    for (int32_t i = 1; i < threads; ++i) {
+        copies.emplace_back(reduction);
+    }
+
+    std::atomic<size_t> next(0);
+    auto work = [&](MinFlowReduction& worker_reduction) {
+        size_t i;
+        while ((i = next++) < count) {
+            task(worker_reduction, i);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (MinFlowReduction& copy : copies) {
+        workers.emplace_back(work, std::ref(copy));
+    }
+    work(reduction);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+
+
+void compute_safe_edges(MinFlowReduction& reduction, int64_t l, std::vector<bool>& safe_edge) {
+
+    FlowNetwork& red = reduction.red;
+    safe_edge.assign(red.arcCount(), false);
+
+    // paths_through[e].size() != 0 iff e is an edge of the path cover
+    std::vector<int32_t> edges;
+    for (int32_t e = 0; e < red.arcCount(); e += 2) {
+        if (reduction.paths_through[e].size() != 0 && red.source(e) != reduction.s && red.target(e) != reduction.t) {
+            edges.push_back(e);
+        }
+    }
+
+    // The results are merged in order, so they do not depend on the number of threads
+    std::vector<char> safe(edges.size(), false);
+    parallel_for_each(reduction, edges.size(), [&](MinFlowReduction& worker_reduction, size_t i) {
+        safe[i] = is_safe_removal(worker_reduction, edges[i], l);
+    });
+
+    for (size_t i = 0; i < edges.size(); ++i) {
+        safe_edge[edges[i]] = safe[i];
+    }
+}
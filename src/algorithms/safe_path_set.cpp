@@ -0,0 +1,28 @@
+#include <algorithms/safe_path_set.h>
+
+using namespace lemon;
+
+
+
+void SafePathSet::filterSafePaths(const std::vector<bool>& keep) {
+    size_t kept = 0;
+    for (size_t k = 0; k < safe_paths.size(); ++k) {
+        if (keep[k]) {
+            safe_paths[kept++] = safe_paths[k];
+        }
+    }
+    safe_paths.resize(kept);
+}
+
+
+
+std::vector<std::pair<std::vector<ListDigraph::Node>, std::vector<std::vector<ListDigraph::Node>>>> SafePathSet::toPairs() const {
+    std::vector<std::pair<std::vector<ListDigraph::Node>, std::vector<std::vector<ListDigraph::Node>>>> safe_paths_per_path(pathCount());
+    for (size_t i = 0; i < pathCount(); ++i) {
+        safe_paths_per_path[i].first = path(i).toVector();
+    }
+    for (const SafePathInterval& safe_path: safe_paths) {
+        safe_paths_per_path[safe_path.path].second.push_back(path(safe_path.path).subpath(safe_path.x, safe_path.y).toVector());
+    }
+    return safe_paths_per_path;
+}
@@ -0,0 +1,328 @@
+#include <binary_instance.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace lemon;
+
+
+
+static size_t bitset_words(int64_t n) {
+    return (n + 63) / 64;
+}
+
+
+static size_t align8(size_t size) {
+    return (size + 7) & ~(size_t) 7;
+}
+
+
+
+size_t BinaryInstance::byteSize(int64_t n, int64_t m) {
+    return sizeof(BinaryInstanceHeader)
+        + n * sizeof(int64_t)
+        + 3 * bitset_words(n) * sizeof(uint64_t)
+        + align8((n + 1 + m) * sizeof(int32_t));
+}
+
+
+
+bool BinaryInstance::hasMagic(const char* data, size_t size) {
+    return size >= sizeof(BINARY_INSTANCE_MAGIC) && std::memcmp(data, BINARY_INSTANCE_MAGIC, sizeof(BINARY_INSTANCE_MAGIC)) == 0;
+}
+
+
+
+BinaryInstance::BinaryInstance(const char* data, size_t size) {
+    if (!hasMagic(data, size)) {
+        throw std::runtime_error("Not a binary instance");
+    }
+    if (size < sizeof(BinaryInstanceHeader)) {
+        throw std::runtime_error("Truncated binary instance");
+    }
+    const BinaryInstanceHeader* header = reinterpret_cast<const BinaryInstanceHeader*>(data);
+    if (header->version != BINARY_INSTANCE_VERSION) {
+        throw std::runtime_error("Unsupported binary instance version " + std::to_string(header->version));
+    }
+    if (header->node_count < 0 || header->node_count >= INT32_MAX || header->arc_count < 0 || header->arc_count >= INT32_MAX
+        || size < byteSize(header->node_count, header->arc_count)) {
+        throw std::runtime_error("Truncated binary instance");
+    }
+    node_count = (int32_t) header->node_count;
+    arc_count = (int32_t) header->arc_count;
+
+    const char* section = data + sizeof(BinaryInstanceHeader);
+    original_id = reinterpret_cast<const int64_t*>(section);
+    section += node_count * sizeof(int64_t);
+    S = reinterpret_cast<const uint64_t*>(section);
+    section += bitset_words(node_count) * sizeof(uint64_t);
+    T = reinterpret_cast<const uint64_t*>(section);
+    section += bitset_words(node_count) * sizeof(uint64_t);
+    U = reinterpret_cast<const uint64_t*>(section);
+    section += bitset_words(node_count) * sizeof(uint64_t);
+    first_out = reinterpret_cast<const int32_t*>(section);
+    section += (node_count + 1) * sizeof(int32_t);
+    targets = reinterpret_cast<const int32_t*>(section);
+
+    if (first_out[0] != 0 || first_out[node_count] != arc_count) {
+        throw std::runtime_error("Corrupted binary instance");
+    }
+    // Non-decreasing offsets from 0 to arc_count keep every out-arc range inside targets
+    for (int32_t v = 0; v < node_count; ++v) {
+        if (first_out[v] > first_out[v + 1]) {
+            throw std::runtime_error("Corrupted binary instance");
+        }
+    }
+}
+
+
+
+MappedFile::MappedFile(const std::string& filename, bool sequential) : bytes(nullptr), length(0) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw std::runtime_error("Cannot open file " + filename);
+    }
+    struct stat info;
+    if (fstat(fd, &info) == -1) {
+        close(fd);
+        throw std::runtime_error("Cannot read file " + filename);
+    }
+    length = info.st_size;
+    if (length > 0) {
+        void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("Cannot map file " + filename);
+        }
+        bytes = static_cast<const char*>(mapping);
+        if (sequential) {
+            madvise(mapping, length, MADV_SEQUENTIAL);
+        }
+    }
+    close(fd);
+}
+
+
+
+MappedFile::~MappedFile() {
+    if (bytes != nullptr) {
+        munmap(const_cast<char*>(bytes), length);
+    }
+}
+
+
+
+// True if the file starts with the given magic
+static bool has_magic(const std::string& filename, const char (&expected)[8]) {
+    char magic[sizeof(expected)];
+    std::ifstream file(filename, std::ios::binary);
+    return file.read(magic, sizeof(magic)) && std::memcmp(magic, expected, sizeof(magic)) == 0;
+}
+
+
+
+bool is_binary_instance(const std::string& filename) {
+    return has_magic(filename, BINARY_INSTANCE_MAGIC);
+}
+
+
+
+void load_binary_instance(const BinaryInstance& instance, ListDigraph& g, ListDigraph::NodeMap<int64_t>& original_id, std::vector<ListDigraph::Node>& S, std::vector<ListDigraph::Node>& T, std::vector<ListDigraph::Node>& U) {
+    int32_t n = instance.nodeCount();
+    g.reserveNode(n);
+    g.reserveArc(instance.arcCount());
+
+    std::vector<ListDigraph::Node> nodes(n);
+    for (int32_t v = 0; v < n; ++v) {
+        nodes[v] = g.addNode();
+        original_id[nodes[v]] = instance.originalId(v);
+    }
+
+    // The out-arcs of a ListDigraph node are iterated from the last added one
+    for (int32_t v = 0; v < n; ++v) {
+        for (int32_t a = instance.outEnd(v) - 1; a >= instance.outBegin(v); --a) {
+            int32_t w = instance.target(a);
+            if (w < 0 || w >= n) {
+                throw std::runtime_error("Corrupted binary instance");
+            }
+            g.addArc(nodes[v], nodes[w]);
+        }
+    }
+
+    ListDigraph::NodeMap<int32_t> index(g);
+    for (int32_t v = 0; v < n; ++v) {
+        index[nodes[v]] = v;
+    }
+    for (ListDigraph::NodeIt v(g) ; v != INVALID; ++v) {
+        if (instance.isSource(index[v])){
+            S.push_back(v);
+        }
+        if (instance.isTarget(index[v])){
+            T.push_back(v);
+        }
+        if (instance.isVertexConstrain(index[v])){
+            U.push_back(v);
+        }
+    }
+}
+
+
+
+template <typename T>
+static void write_array(std::ostream& out, const std::vector<T>& array) {
+    out.write(reinterpret_cast<const char*>(array.data()), array.size() * sizeof(T));
+}
+
+
+
+void write_binary_instance(std::ostream& out, const ListDigraph& g, const ListDigraph::NodeMap<int64_t>& original_id, const std::vector<ListDigraph::Node>& S, const std::vector<ListDigraph::Node>& T, const std::vector<ListDigraph::Node>& U) {
+    std::vector<ListDigraph::Node> nodes;
+    for (ListDigraph::NodeIt v(g) ; v != INVALID; ++v) {
+        nodes.push_back(v);
+    }
+    std::sort(nodes.begin(), nodes.end(), [&g](ListDigraph::Node u, ListDigraph::Node v) { return g.id(u) < g.id(v); });
+    int32_t n = (int32_t) nodes.size();
+
+    ListDigraph::NodeMap<int32_t> index(g);
+    for (int32_t v = 0; v < n; ++v) {
+        index[nodes[v]] = v;
+    }
+
+    std::vector<int64_t> ids(n);
+    std::vector<int32_t> first_out(n + 1, 0);
+    std::vector<int32_t> targets;
+    for (int32_t v = 0; v < n; ++v) {
+        ids[v] = original_id[nodes[v]];
+        for (ListDigraph::OutArcIt e(g, nodes[v]); e != INVALID; ++e) {
+            targets.push_back(index[g.target(e)]);
+        }
+        first_out[v + 1] = (int32_t) targets.size();
+    }
+
+    auto bitset = [&](const std::vector<ListDigraph::Node>& set) {
+        std::vector<uint64_t> bits(bitset_words(n), 0);
+        for (ListDigraph::Node v: set) {
+            bits[index[v] >> 6] |= (uint64_t) 1 << (index[v] & 63);
+        }
+        return bits;
+    };
+
+    BinaryInstanceHeader header;
+    std::memcpy(header.magic, BINARY_INSTANCE_MAGIC, sizeof(header.magic));
+    header.version = BINARY_INSTANCE_VERSION;
+    header.reserved = 0;
+    header.node_count = n;
+    header.arc_count = (int64_t) targets.size();
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    write_array(out, ids);
+    write_array(out, bitset(S));
+    write_array(out, bitset(T));
+    write_array(out, bitset(U));
+    write_array(out, first_out);
+    write_array(out, targets);
+    if ((first_out.size() + targets.size()) % 2 != 0) {
+        write_array(out, std::vector<int32_t>(1, 0)); // Padding to a multiple of 8 bytes
+    }
+}
+
+
+
+InstanceContainer::InstanceContainer(const std::string& filename, bool sequential) : file(filename, sequential) {
+    const char* data = file.data();
+    size_t size = file.size();
+    if (size < sizeof(INSTANCE_CONTAINER_MAGIC) || std::memcmp(data, INSTANCE_CONTAINER_MAGIC, sizeof(INSTANCE_CONTAINER_MAGIC)) != 0) {
+        throw std::runtime_error("Not an instance container " + filename);
+    }
+    if (size < sizeof(InstanceContainerHeader)) {
+        throw std::runtime_error("Truncated instance container " + filename);
+    }
+    const InstanceContainerHeader* header = reinterpret_cast<const InstanceContainerHeader*>(data);
+    if (header->version != INSTANCE_CONTAINER_VERSION) {
+        throw std::runtime_error("Unsupported instance container version " + std::to_string(header->version));
+    }
+    if (header->instance_count < 0 || header->index_offset < (int64_t) sizeof(InstanceContainerHeader) || header->index_offset % 8 != 0
+        || (size_t) header->index_offset > size || (size - header->index_offset) / sizeof(InstanceContainerEntry) < (size_t) header->instance_count) {
+        throw std::runtime_error("Truncated instance container " + filename);
+    }
+    instance_count = header->instance_count;
+    index = reinterpret_cast<const InstanceContainerEntry*>(data + header->index_offset);
+    names = reinterpret_cast<const char*>(index + instance_count);
+
+    size_t names_size = size - (names - data);
+    for (size_t i = 0; i < instance_count; ++i) {
+        const InstanceContainerEntry& entry = index[i];
+        if (entry.offset < 0 || entry.size < 0 || entry.offset % 8 != 0 || (size_t) entry.offset > size || (size_t) entry.size > size - entry.offset
+            || entry.name_offset < 0 || entry.name_length < 0 || (size_t) entry.name_offset > names_size || (size_t) entry.name_length > names_size - entry.name_offset) {
+            throw std::runtime_error("Corrupted instance container " + filename);
+        }
+    }
+}
+
+
+
+std::string InstanceContainer::name(size_t i) const {
+    return std::string(names + index[i].name_offset, index[i].name_length);
+}
+
+
+
+BinaryInstance InstanceContainer::instance(size_t i) const {
+    return BinaryInstance(file.data() + index[i].offset, index[i].size);
+}
+
+
+
+InstanceContainerWriter::InstanceContainerWriter(const std::string& filename) : out(filename, std::ios::binary) {
+    if (!out) {
+        throw std::runtime_error("Cannot create file " + filename);
+    }
+    // The header is written again by close(), once the index offset is known
+    InstanceContainerHeader header = {};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+
+
+void InstanceContainerWriter::add(const std::string& name, const ListDigraph& g, const ListDigraph::NodeMap<int64_t>& original_id, const std::vector<ListDigraph::Node>& S, const std::vector<ListDigraph::Node>& T, const std::vector<ListDigraph::Node>& U) {
+    InstanceContainerEntry entry;
+    entry.offset = out.tellp();
+    write_binary_instance(out, g, original_id, S, T, U);
+    entry.size = (int64_t) out.tellp() - entry.offset;
+    entry.name_offset = names.size();
+    entry.name_length = name.size();
+    names += name;
+    index.push_back(entry);
+}
+
+
+
+void InstanceContainerWriter::close() {
+    InstanceContainerHeader header;
+    std::memcpy(header.magic, INSTANCE_CONTAINER_MAGIC, sizeof(header.magic));
+    header.version = INSTANCE_CONTAINER_VERSION;
+    header.reserved = 0;
+    header.instance_count = index.size();
+    header.index_offset = out.tellp();
+
+    write_array(out, index);
+    out.write(names.data(), names.size());
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.close();
+    if (!out) {
+        throw std::runtime_error("Cannot write the instance container");
+    }
+}
+
+
+
+bool is_instance_container(const std::string& filename) {
+    return has_magic(filename, INSTANCE_CONTAINER_MAGIC);
+}
@@ -0,0 +1,113 @@
+#include <canonical_form.h>
+
+#include <algorithm>
+
+using namespace lemon;
+
+
+
+// Mixes x into the hash h (splitmix64 finalizer)
+static uint64_t combine(uint64_t h, uint64_t x) {
+    uint64_t z = h ^ (x + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2));
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+
+
+// Mixes the multiset of colors into the hash h
+static uint64_t combine_multiset(uint64_t h, std::vector<uint64_t>& colors) {
+    std::sort(colors.begin(), colors.end());
+    h = combine(h, colors.size());
+    for (uint64_t color: colors) {
+        h = combine(h, color);
+    }
+    return h;
+}
+
+
+
+CanonicalForm::CanonicalForm(const ListDigraph& g, const std::vector<ListDigraph::Node>& S, const std::vector<ListDigraph::Node>& T, const std::vector<ListDigraph::Node>& U) {
+    size_t ids = g.maxNodeId() + 1;
+    std::vector<ListDigraph::Node> nodes;
+    for (ListDigraph::NodeIt v(g); v != INVALID; ++v) {
+        nodes.push_back(v);
+    }
+    int32_t n = (int32_t) nodes.size();
+
+    std::vector<uint64_t> flags(ids, 0);
+    for (ListDigraph::Node v: S) flags[g.id(v)] |= 1;
+    for (ListDigraph::Node v: T) flags[g.id(v)] |= 2;
+    for (ListDigraph::Node v: U) flags[g.id(v)] |= 4;
+
+    // Kahn's algorithm
+    std::vector<int32_t> in_degree(ids, 0);
+    for (ListDigraph::ArcIt e(g); e != INVALID; ++e) {
+        ++in_degree[g.id(g.target(e))];
+    }
+    std::vector<ListDigraph::Node> order;
+    for (ListDigraph::Node v: nodes) {
+        if (in_degree[g.id(v)] == 0) order.push_back(v);
+    }
+    for (size_t i = 0; i < order.size(); ++i) {
+        for (ListDigraph::OutArcIt e(g, order[i]); e != INVALID; ++e) {
+            if (--in_degree[g.id(g.target(e))] == 0) order.push_back(g.target(e));
+        }
+    }
+
+    std::vector<uint64_t> forward(ids), backward(ids), color(ids);
+    std::vector<uint64_t> colors;
+    for (ListDigraph::Node v: order) {
+        colors.clear();
+        for (ListDigraph::InArcIt e(g, v); e != INVALID; ++e) colors.push_back(forward[g.id(g.source(e))]);
+        forward[g.id(v)] = combine_multiset(flags[g.id(v)], colors);
+    }
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        colors.clear();
+        for (ListDigraph::OutArcIt e(g, *it); e != INVALID; ++e) colors.push_back(backward[g.id(g.target(e))]);
+        backward[g.id(*it)] = combine_multiset(flags[g.id(*it)], colors);
+    }
+    for (ListDigraph::Node v: nodes) {
+        color[g.id(v)] = combine(forward[g.id(v)], backward[g.id(v)]);
+    }
+
+    // One more round with the colors of the neighbours
+    std::vector<uint64_t> refined(ids);
+    for (ListDigraph::Node v: nodes) {
+        colors.clear();
+        for (ListDigraph::InArcIt e(g, v); e != INVALID; ++e) colors.push_back(color[g.id(g.source(e))]);
+        uint64_t h = combine_multiset(color[g.id(v)], colors);
+        colors.clear();
+        for (ListDigraph::OutArcIt e(g, v); e != INVALID; ++e) colors.push_back(color[g.id(g.target(e))]);
+        refined[g.id(v)] = combine_multiset(h, colors);
+    }
+
+    std::vector<ListDigraph::Node> vertices_by_position = nodes;
+    std::stable_sort(vertices_by_position.begin(), vertices_by_position.end(), [&](ListDigraph::Node u, ListDigraph::Node v) {
+        return refined[g.id(u)] < refined[g.id(v)];
+    });
+    positions_by_id.assign(ids, -1);
+    for (int32_t p = 0; p < n; ++p) {
+        positions_by_id[g.id(vertices_by_position[p])] = p;
+    }
+
+    // n, m, and for every position its flags, out-degree and sorted out-neighbours
+    encoding.push_back(n);
+    encoding.push_back(countArcs(g));
+    std::vector<int32_t> targets;
+    for (ListDigraph::Node v: vertices_by_position) {
+        targets.clear();
+        for (ListDigraph::OutArcIt e(g, v); e != INVALID; ++e) targets.push_back(position(g.target(e)));
+        std::sort(targets.begin(), targets.end());
+        encoding.push_back(flags[g.id(v)]);
+        encoding.push_back(targets.size());
+        encoding.insert(encoding.end(), targets.begin(), targets.end());
+    }
+
+    uint64_t h = 0;
+    for (int64_t x: encoding) {
+        h = combine(h, x);
+    }
+    key_hash = (size_t) h;
+}
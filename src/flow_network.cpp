@@ -0,0 +1,74 @@
+#include <flow_network.h>
+
+
+const int32_t FlowNetwork::INVALID_ARC;
+
+
+
+FlowNetwork::FlowNetwork() : node_count(0), base_arc_count(0), built(false) {}
+
+
+
+int32_t FlowNetwork::addNode() {
+    return node_count++;
+}
+
+
+
+int32_t FlowNetwork::addArc(int32_t u, int32_t v) {
+    int32_t a = (int32_t) heads.size();
+    heads.push_back(v);
+    heads.push_back(u);
+    disabled.push_back(false);
+
+    if (built) {
+        temp_next.push_back(temp_first[u]);
+        temp_first[u] = a;
+        temp_next.push_back(temp_first[v]);
+        temp_first[v] = a + 1;
+    }
+
+    return a;
+}
+
+
+
+void FlowNetwork::build() {
+    base_arc_count = (int32_t) heads.size();
+
+    // Counting sort of the arcs by source
+    first_out.assign(node_count + 1, 0);
+    for (int32_t a = 0; a < base_arc_count; ++a) {
+        first_out[source(a) + 1]++;
+    }
+    for (int32_t v = 0; v < node_count; ++v) {
+        first_out[v + 1] += first_out[v];
+    }
+
+    out_arcs.resize(base_arc_count);
+    std::vector<int32_t> next(first_out.begin(), first_out.end() - 1);
+    for (int32_t a = 0; a < base_arc_count; ++a) {
+        out_arcs[next[source(a)]++] = a;
+    }
+
+    temp_first.assign(node_count, INVALID_ARC);
+    temp_next.clear();
+    built = true;
+}
+
+
+
+void FlowNetwork::popArcs(int32_t arc_count) {
+    while (arcCount() > arc_count) {
+        // Unlink the last pair, its twin was linked last
+        int32_t a = arcCount() - 2;
+        temp_first[target(a)] = temp_next[a + 1 - base_arc_count];
+        temp_first[source(a)] = temp_next[a - base_arc_count];
+
+        temp_next.pop_back();
+        temp_next.pop_back();
+        heads.pop_back();
+        heads.pop_back();
+        disabled.pop_back();
+    }
+}
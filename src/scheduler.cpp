@@ -0,0 +1,100 @@
+#include <scheduler.h>
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+
+
+double estimate_cost(int64_t nodes, int64_t arcs, int64_t width) {
+    return (double) std::max<int64_t>(width, 1) * std::max<int64_t>(width, 1) * nodes * (nodes + arcs);
+}
+
+
+
+// Tasks assigned to a thread, by decreasing cost
+struct TaskQueue {
+    std::mutex mutex;
+    std::deque<size_t> tasks;
+    double remaining_cost = 0;
+};
+
+
+
+// Takes the largest task of the queue (or the smallest one, if stealing), false if it is empty
+static bool take_task(TaskQueue& queue, const std::vector<double>& costs, bool steal, size_t& task) {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    if (steal) {
+        task = queue.tasks.back();
+        queue.tasks.pop_back();
+    } else {
+        task = queue.tasks.front();
+        queue.tasks.pop_front();
+    }
+    queue.remaining_cost -= costs[task];
+    return true;
+}
+
+
+
+void run_largest_first(const std::vector<double>& costs, int32_t threads, const std::function<void(size_t)>& task) {
+
+    threads = std::max<int32_t>(1, std::min<size_t>(threads, costs.size()));
+
+    std::vector<size_t> order(costs.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&costs](size_t a, size_t b) { return costs[a] > costs[b]; });
+
+    // Deal the tasks largest first to the least loaded thread
+    std::vector<TaskQueue> queues(threads);
+    for (size_t i : order) {
+        TaskQueue* least_loaded = &queues[0];
+        for (TaskQueue& queue : queues) {
+            if (queue.remaining_cost < least_loaded->remaining_cost) {
+                least_loaded = &queue;
+            }
+        }
+        least_loaded->tasks.push_back(i);
+        least_loaded->remaining_cost += costs[i];
+    }
+
+    auto work = [&](int32_t id) {
+        size_t i;
+        while (true) {
+            if (!take_task(queues[id], costs, false, i)) {
+                // Steal from the thread with the most remaining cost, until every queue is empty
+                // (no new tasks are added, so then there is nothing left to do)
+                bool stolen = false;
+                while (!stolen) {
+                    int32_t victim = -1;
+                    double max_remaining_cost = -1;
+                    for (int32_t other = 0; other < threads; ++other) {
+                        std::lock_guard<std::mutex> lock(queues[other].mutex);
+                        if (!queues[other].tasks.empty() && queues[other].remaining_cost > max_remaining_cost) {
+                            victim = other;
+                            max_remaining_cost = queues[other].remaining_cost;
+                        }
+                    }
+                    if (victim == -1) return;
+                    stolen = take_task(queues[victim], costs, true, i);
+                }
+            }
+            task(i);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int32_t id = 1; id < threads; ++id) {
+        workers.emplace_back(work, id);
+    }
+    work(0);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
@@ -1,10 +1,17 @@
 #include <utils.h>
+#include <binary_instance.h>
 
 #include <lemon/lgf_reader.h>
 
 using namespace lemon;
 
-void load_problem_instance(char* filename, ListDigraph& g, ListDigraph::NodeMap<int64_t>& original_id, std::vector<ListDigraph::Node>& S, std::vector<ListDigraph::Node>& T, std::vector<ListDigraph::Node>& U) {
+void load_problem_instance(const std::string& filename, ListDigraph& g, ListDigraph::NodeMap<int64_t>& original_id, std::vector<ListDigraph::Node>& S, std::vector<ListDigraph::Node>& T, std::vector<ListDigraph::Node>& U) {
+    if (is_binary_instance(filename)) {
+        MappedFile file(filename);
+        load_binary_instance(BinaryInstance(file.data(), file.size()), g, original_id, S, T, U);
+        return;
+    }
+
     ListDigraph::NodeMap<bool> in_S(g);
     ListDigraph::NodeMap<bool> in_T(g);
     ListDigraph::NodeMap<bool> in_U(g);